@@ -0,0 +1,406 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Call overhead compared to plain C callbacks
+
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+
+#include <voidstar.h>
+#include <voidstar/any_closure.h>
+#include <voidstar/awaitable_callback.h>
+#include <voidstar/banked_closure.h>
+#include <voidstar/closure_registry.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/dispatched_closure.h>
+#include <voidstar/invoker.h>
+#include <voidstar/metrics.h>
+#include <voidstar/queued_closure.h>
+#include <voidstar/rebindable_closure.h>
+#include <voidstar/retirable_closure.h>
+#include <voidstar/static_closure.h>
+#include <voidstar/work_stealing_pool.h>
+#include <voidstar/wrap.h>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace voidstar::benchmarks {
+namespace {
+
+constexpr int max_threads = 8;
+
+struct increment {
+  int step;
+  auto operator()(int x) const noexcept -> int { return x + step; }
+};
+
+struct stateless_increment {
+  auto operator()(int x) const noexcept -> int { return x + 1; }
+};
+
+struct accumulate {
+  std::atomic<int> *sink;
+  void operator()(int x) const noexcept {
+    sink->fetch_add(x, std::memory_order_relaxed);
+  }
+};
+
+/// @brief Baseline: a C callback that does not need context.
+[[gnu::noinline]] auto direct_target(int x) -> int { return x + 1; }
+
+/// @brief Baseline: a hand-written thunk for an API with `user_data`.
+[[gnu::noinline]] auto user_data_thunk(void *user_data, int x) -> int {
+  return (*static_cast<increment const *>(user_data))(x);
+}
+
+void BM_CallDirect(benchmark::State &state) {
+  auto fn = &direct_target;
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallUserDataThunk(benchmark::State &state) {
+  static increment const payload{1};
+  auto fn = &user_data_thunk;
+  void *user_data = const_cast<increment *>(&payload);
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(user_data, x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallWrapped(benchmark::State &state) {
+  // Pass-through cost of a decorator whose hook compiles away
+  struct pass_through {
+    void before(int /* x */) const noexcept {}
+  };
+
+  static auto const wrapped = wrap(&direct_target, pass_through{});
+  auto fn = wrapped.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallClosure(benchmark::State &state) {
+  // Shared by all threads
+  static closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallStatelessClosure(benchmark::State &state) {
+  static stateless_closure<int(int), stateless_increment> const cls{};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallStaticClosure(benchmark::State &state) {
+  auto fn = static_closure<stateless_increment{}>::get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallDirectClosure(benchmark::State &state) {
+  static direct_closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallBankedClosure(benchmark::State &state) {
+  static banked_closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallAnyClosure(benchmark::State &state) {
+  static any_closure<int(int)> const cls{increment{1}};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallFunctionClosure(benchmark::State &state) {
+  // The std::function layering that any_closure avoids
+  static closure<int(int), std::function<int(int)>> const cls{increment{1}};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallRetirableClosure(benchmark::State &state) {
+  // Measures the cost of in-flight accounting under contention
+  static retirable_closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallRebindableClosure(benchmark::State &state) {
+  static rebindable_closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallInstrumentedClosure(benchmark::State &state) {
+  static instrumented_closure<int(int), increment> const cls{1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_CallClosureStruct(benchmark::State &state) {
+  static closure<sig_struct, payload_struct> const cls{};
+  auto fn = cls.get();
+  record r{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    fn(r, r);
+    benchmark::ClobberMemory();
+  }
+}
+
+/// @brief A coroutine that starts eagerly and is destroyed when it finishes.
+struct eager_task {
+  struct promise_type {
+    auto get_return_object() noexcept -> eager_task { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+auto await_until_zero(awaitable_callback<void(int)> &callback, int &sink)
+    -> eager_task {
+  while (int const value = co_await callback) {
+    sink += value;
+  }
+}
+
+void BM_AwaitCallback(benchmark::State &state) {
+  // One callback invocation resuming one suspended coroutine
+  awaitable_callback<void(int)> callback;
+  int sink = 0;
+  await_until_zero(callback, sink);
+  auto fn = callback.get();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    fn(1);
+  }
+  benchmark::DoNotOptimize(sink);
+
+  // Let the coroutine finish
+  fn(0);
+}
+
+void BM_QueuedClosure(benchmark::State &state) {
+  // One enqueue per call, drained in batches by the same thread
+  queued_closure<void(int)> queue{{.capacity = 1024}};
+  auto fn = queue.get();
+  int sink = 0;
+  int pending = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    fn(1);
+    if (++pending == 256) {
+      queue.drain([&](int x) { sink += x; });
+      pending = 0;
+    }
+  }
+  queue.drain([&](int x) { sink += x; });
+  benchmark::DoNotOptimize(sink);
+}
+
+void BM_DispatchedClosure(benchmark::State &state) {
+  // Submission cost only; the pool runs the calls concurrently
+  static work_stealing_pool pool{2};
+  static std::atomic<int> sink = 0;
+  static dispatched_closure<void(int), accumulate> const cls{pool, &sink};
+  auto fn = cls.get();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    fn(1);
+  }
+  cls.payload().wait_idle();
+}
+
+void BM_DispatchedClosureRendezvous(benchmark::State &state) {
+  static work_stealing_pool pool{2};
+  static dispatched_closure<int(int), increment> const cls{pool, 1};
+  auto fn = cls.get();
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = fn(x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+void BM_Invoker(benchmark::State &state) {
+  invoker<int(int)> const invoke;
+  auto fn = &direct_target;
+  int x = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fn);
+    x = invoke(fn, x);
+    benchmark::DoNotOptimize(x);
+  }
+}
+
+/// @brief Looking up a function pointer among `range(0)` registered closures.
+void BM_FindClosure(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  std::vector<std::unique_ptr<registered<direct_closure<int(int), increment>>>>
+      closures;
+  closures.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    closures.push_back(
+        std::make_unique<registered<direct_closure<int(int), increment>>>(1));
+  }
+
+  std::size_t i = 0;
+  for (auto _ : state) {
+    auto const info = find_closure(closures[i]->get());
+    benchmark::DoNotOptimize(info);
+    i = (i + 1) % count;
+  }
+}
+
+BENCHMARK(BM_CallDirect)->Name("Call/direct")->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallUserDataThunk)
+    ->Name("Call/user_data_thunk")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallWrapped)->Name("Call/wrap")->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallClosure)->Name("Call/closure")->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallStatelessClosure)
+    ->Name("Call/stateless_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallStaticClosure)
+    ->Name("Call/static_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallDirectClosure)
+    ->Name("Call/direct_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallBankedClosure)
+    ->Name("Call/banked_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallAnyClosure)
+    ->Name("Call/any_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallFunctionClosure)
+    ->Name("Call/closure/std::function")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallRebindableClosure)
+    ->Name("Call/rebindable_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallRetirableClosure)
+    ->Name("Call/retirable_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallInstrumentedClosure)
+    ->Name("Call/instrumented_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_CallClosureStruct)
+    ->Name("Call/closure/void(record,record)")
+    ->ThreadRange(1, max_threads);
+
+BENCHMARK(BM_AwaitCallback)->Name("Await/awaitable_callback");
+
+BENCHMARK(BM_QueuedClosure)->Name("Enqueue/queued_closure");
+
+BENCHMARK(BM_DispatchedClosure)
+    ->Name("Dispatch/dispatched_closure")
+    ->ThreadRange(1, max_threads);
+BENCHMARK(BM_DispatchedClosureRendezvous)
+    ->Name("Dispatch/dispatched_closure/rendezvous");
+
+BENCHMARK(BM_Invoker)->Name("Invoke/invoker")->ThreadRange(1, max_threads);
+
+BENCHMARK(BM_FindClosure)
+    ->Name("Lookup/find_closure")
+    ->RangeMultiplier(8)
+    ->Range(64, 262144);
+
+} // namespace
+} // namespace voidstar::benchmarks
@@ -0,0 +1,50 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Signatures and payloads shared by all benchmarks
+
+#ifndef VOIDSTAR_BENCHMARKS_COMMON_H
+#define VOIDSTAR_BENCHMARKS_COMMON_H
+
+#include <voidstar/layout.h>
+
+#include <tuple>
+
+namespace voidstar::benchmarks {
+
+struct record {
+  int id;
+  float values[4];
+};
+
+using sig_void = void();
+using sig_scalar = int(int, double, void *);
+using sig_struct = void(record, record);
+
+struct payload_void {
+  void operator()() const noexcept {}
+};
+
+struct payload_scalar {
+  auto operator()(int x, double y, void *) const noexcept -> int {
+    return x + static_cast<int>(y);
+  }
+};
+
+struct payload_struct {
+  void operator()(record, record) const noexcept {}
+};
+
+struct payload_stateless {
+  auto operator()(int x, double y, void *) const noexcept -> int {
+    return x + static_cast<int>(y);
+  }
+};
+
+} // namespace voidstar::benchmarks
+
+template <> struct voidstar::layout<voidstar::benchmarks::record> {
+  using members = std::tuple<int, float[4]>;
+};
+
+#endif
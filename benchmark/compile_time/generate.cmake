@@ -0,0 +1,87 @@
+# voidstar library. Copyright (c) 2025 OLEGSHA
+# SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+# Generates a translation unit that instantiates closures for SIGNATURES
+# distinct call signatures, cycling through scalars, structs passed by value
+# and structs with bounded arrays.
+#
+# Usage: cmake -DSIGNATURES=<K> -DOUTPUT=<file.cpp> -P generate.cmake
+
+if(NOT DEFINED SIGNATURES OR NOT DEFINED OUTPUT)
+  message(FATAL_ERROR "SIGNATURES and OUTPUT must be defined")
+endif()
+
+set(_header
+    "// Generated by generate.cmake with SIGNATURES=${SIGNATURES}. Do not edit.
+
+#include <voidstar.h>
+
+#include <cstddef>
+#include <tuple>
+
+namespace {
+
+template <typename R> struct returns {
+  auto operator()(auto &&...) const -> R { return R{}; }
+};
+
+template <> struct returns<void> {
+  void operator()(auto &&...) const {}
+};
+
+template <typename F, typename R> auto instantiate() -> void * {
+  static voidstar::closure<F, returns<R>> const cls{};
+  return reinterpret_cast<void *>(cls.get());
+}
+
+")
+
+set(_types "")
+set(_layouts "")
+set(_calls "")
+
+math(EXPR _last "${SIGNATURES} - 1")
+foreach(i RANGE ${_last})
+  math(EXPR _kind "${i} % 4")
+  math(EXPR _small "${i} % 7 + 1")
+  math(EXPR _large "${i} % 64 + 64")
+
+  string(APPEND _types
+         "struct s${i} { int a; float b[${_small}]; double c; };\n"
+         "struct a${i} { char data[${_large}]; s${i} inner; };\n")
+  string(APPEND _layouts
+         "template <> struct voidstar::layout<s${i}> {\n"
+         "  using members = std::tuple<int, float[${_small}], double>;\n"
+         "};\n"
+         "template <> struct voidstar::layout<a${i}> {\n"
+         "  using members = std::tuple<char[${_large}], s${i}>;\n"
+         "};\n")
+
+  if(_kind EQUAL 0)
+    string(APPEND _calls "  instantiate<long(s${i} *, int, double), long>(),\n")
+  elseif(_kind EQUAL 1)
+    string(APPEND _calls "  instantiate<s${i}(s${i}, int), s${i}>(),\n")
+  elseif(_kind EQUAL 2)
+    string(APPEND _calls "  instantiate<void(a${i}, float), void>(),\n")
+  else()
+    string(APPEND _calls
+           "  instantiate<double(s${i} const *, s${i}, a${i}), double>(),\n")
+  endif()
+endforeach()
+
+file(
+  WRITE "${OUTPUT}.tmp"
+  "${_header}"
+  "${_types}"
+  "} // namespace\n\n"
+  "${_layouts}\n"
+  "auto compile_time_signatures() -> std::size_t {\n"
+  "  void *const pointers[] = {\n"
+  "${_calls}"
+  "  };\n"
+  "  return sizeof(pointers);\n"
+  "}\n")
+
+# Avoid rebuilding when nothing changed
+file(COPY_FILE "${OUTPUT}.tmp" "${OUTPUT}" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT}.tmp")
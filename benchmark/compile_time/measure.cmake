@@ -0,0 +1,49 @@
+# voidstar library. Copyright (c) 2025 OLEGSHA
+# SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+# Measures frontend time, full compile time and object size of SOURCE.
+#
+# Usage: cmake -DCOMPILER=<c++> -DFLAGS=<flag|flag|...> -DSOURCE=<file.cpp>
+#              -DOBJECT=<file.o> -P measure.cmake
+
+if(NOT DEFINED COMPILER
+   OR NOT DEFINED SOURCE
+   OR NOT DEFINED OBJECT)
+  message(FATAL_ERROR "COMPILER, SOURCE and OBJECT must be defined")
+endif()
+
+string(REPLACE "|" ";" FLAGS "${FLAGS}")
+
+# Seconds since the epoch with sub-second precision where supported
+function(_now out)
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    # One call, so both parts come from the same reading
+    string(TIMESTAMP _now "%s%f")
+    set(${out} "${_now}" PARENT_SCOPE)
+  else()
+    string(TIMESTAMP _seconds "%s")
+    set(${out} "${_seconds}000000" PARENT_SCOPE)
+  endif()
+endfunction()
+
+function(_timed_compile out_ms)
+  _now(_start)
+  execute_process(
+    COMMAND ${COMPILER} ${FLAGS} ${ARGN} "${SOURCE}"
+    RESULT_VARIABLE _result
+    ERROR_VARIABLE _errors)
+  _now(_end)
+  if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "Compilation failed:\n${_errors}")
+  endif()
+  math(EXPR _ms "(${_end} - ${_start}) / 1000")
+  set(${out_ms} ${_ms} PARENT_SCOPE)
+endfunction()
+
+_timed_compile(_frontend_ms -fsyntax-only)
+_timed_compile(_compile_ms -c -o "${OBJECT}")
+file(SIZE "${OBJECT}" _object_bytes)
+
+message(STATUS "Frontend: ${_frontend_ms} ms")
+message(STATUS "Compile:  ${_compile_ms} ms")
+message(STATUS "Object:   ${_object_bytes} bytes")
@@ -0,0 +1,73 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Memory footprint of live closures
+
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+
+#include <voidstar.h>
+
+#include <cstddef>
+#include <fstream>
+#include <memory>
+
+#include <unistd.h>
+
+namespace voidstar::benchmarks {
+namespace {
+
+/// @brief Resident set size of this process in bytes, or 0 if unknown.
+auto resident_bytes() -> std::size_t {
+  std::ifstream statm{"/proc/self/statm"};
+  std::size_t total_pages = 0;
+  std::size_t resident_pages = 0;
+  if (not(statm >> total_pages >> resident_pages)) {
+    return 0;
+  }
+  return resident_pages * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+template <typename F, typename P> void BM_Footprint(benchmark::State &state) {
+  using closure_type = closure<F, P>;
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  double rss_per_closure = 0;
+
+  for (auto _ : state) {
+    auto const before = resident_bytes();
+    auto closures = std::make_unique<closure_type[]>(count);
+    auto const after = resident_bytes();
+
+    benchmark::DoNotOptimize(closures.get());
+    // The kernel may reclaim other pages meanwhile, so RSS can shrink
+    auto const grown = after > before ? after - before : 0;
+    rss_per_closure = static_cast<double>(grown) / count;
+  }
+
+  state.counters["sizeof"] = sizeof(closure_type);
+  state.counters["rss_bytes_per_closure"] = rss_per_closure;
+  state.counters["closures"] = static_cast<double>(count);
+}
+
+constexpr std::int64_t million = 1'000'000;
+
+BENCHMARK(BM_Footprint<sig_void, payload_void>)
+    ->Name("Footprint/void()")
+    ->Arg(million)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Footprint<sig_scalar, payload_scalar>)
+    ->Name("Footprint/int(int,double,void*)")
+    ->Arg(million)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Footprint<sig_struct, payload_struct>)
+    ->Name("Footprint/void(record,record)")
+    ->Arg(million)
+    ->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace voidstar::benchmarks
@@ -0,0 +1,153 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Construction and destruction latency
+
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_arena.h>
+#include <voidstar/closure_array.h>
+#include <voidstar/closure_pool.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/lazy_closure.h>
+#include <voidstar/static_closure.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace voidstar::benchmarks {
+namespace {
+
+constexpr int max_threads = 8;
+
+template <typename F, typename P> void BM_Closure(benchmark::State &state) {
+  for (auto _ : state) {
+    closure<F, P> cls{};
+    benchmark::DoNotOptimize(cls.get());
+  }
+}
+
+template <typename F, typename P>
+void BM_StatelessClosure(benchmark::State &state) {
+  for (auto _ : state) {
+    stateless_closure<F, P> cls{};
+    benchmark::DoNotOptimize(cls.get());
+  }
+}
+
+template <typename F, typename P>
+void BM_DirectClosure(benchmark::State &state) {
+  for (auto _ : state) {
+    direct_closure<F, P> cls{};
+    benchmark::DoNotOptimize(cls.get());
+  }
+}
+
+template <typename F, typename P>
+void BM_PooledClosure(benchmark::State &state) {
+  closure_pool<F> pool{{.background_refill = false}};
+
+  for (auto _ : state) {
+    pooled_closure<F, P> cls{pool};
+    benchmark::DoNotOptimize(cls.get());
+  }
+}
+
+/// @brief A lazy closure whose function pointer is never requested.
+template <typename F, typename P>
+void BM_LazyClosureUnused(benchmark::State &state) {
+  for (auto _ : state) {
+    lazy_closure<F, P> cls{};
+    benchmark::DoNotOptimize(&cls);
+  }
+}
+
+/// @brief Many closures created one by one, as a baseline for closure_array.
+template <typename F, typename P>
+void BM_UniqueClosures(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    std::vector<unique_closure<F, P>> closures;
+    closures.reserve(count);
+    for (std::size_t i = 0; i < count; i++) {
+      closures.emplace_back();
+    }
+    benchmark::DoNotOptimize(closures.back().get());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename F, typename P>
+void BM_ClosureArray(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    closure_array<F, P> closures{count};
+    benchmark::DoNotOptimize(closures.get(count - 1));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename F, typename P>
+void BM_ClosureArena(benchmark::State &state) {
+  auto const count = static_cast<std::size_t>(state.range(0));
+  closure_arena arena;
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < count; i++) {
+      benchmark::DoNotOptimize(arena.emplace<F, P>().get());
+    }
+    arena.release();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Closure<sig_void, payload_void>)->Name("Closure/void()");
+BENCHMARK(BM_Closure<sig_scalar, payload_scalar>)
+    ->Name("Closure/concurrent/int(int,double,void*)")
+    ->ThreadRange(1, max_threads)
+    ->UseRealTime();
+BENCHMARK(BM_Closure<sig_scalar, payload_scalar>)
+    ->Name("Closure/int(int,double,void*)");
+BENCHMARK(BM_Closure<sig_struct, payload_struct>)
+    ->Name("Closure/void(record,record)");
+
+BENCHMARK(BM_Closure<sig_scalar, payload_stateless>)
+    ->Name("Closure/stateless");
+BENCHMARK(BM_StatelessClosure<sig_scalar, payload_stateless>)
+    ->Name("StatelessClosure/int(int,double,void*)");
+
+BENCHMARK(BM_DirectClosure<sig_void, payload_void>)
+    ->Name("DirectClosure/void()");
+BENCHMARK(BM_DirectClosure<sig_scalar, payload_scalar>)
+    ->Name("DirectClosure/int(int,double,void*)");
+
+BENCHMARK(BM_PooledClosure<sig_void, payload_void>)
+    ->Name("PooledClosure/void()");
+BENCHMARK(BM_PooledClosure<sig_scalar, payload_scalar>)
+    ->Name("PooledClosure/int(int,double,void*)");
+BENCHMARK(BM_PooledClosure<sig_struct, payload_struct>)
+    ->Name("PooledClosure/void(record,record)");
+
+BENCHMARK(BM_LazyClosureUnused<sig_scalar, payload_scalar>)
+    ->Name("LazyClosure/unused/int(int,double,void*)");
+
+BENCHMARK(BM_UniqueClosures<sig_scalar, payload_scalar>)
+    ->Name("UniqueClosures/int(int,double,void*)")
+    ->RangeMultiplier(8)
+    ->Range(64, 32768);
+BENCHMARK(BM_ClosureArray<sig_scalar, payload_scalar>)
+    ->Name("ClosureArray/int(int,double,void*)")
+    ->RangeMultiplier(8)
+    ->Range(64, 32768);
+BENCHMARK(BM_ClosureArena<sig_scalar, payload_scalar>)
+    ->Name("ClosureArena/int(int,double,void*)")
+    ->RangeMultiplier(8)
+    ->Range(64, 32768);
+
+} // namespace
+} // namespace voidstar::benchmarks
@@ -0,0 +1,18 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <benchmark/benchmark.h>
+
+auto main(int argc, char *argv[]) -> int {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  // Allows comparing reports across releases
+  benchmark::AddCustomContext("voidstar_version", VOIDSTAR_VERSION);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,164 @@
+# voidstar library. Copyright (c) 2025 OLEGSHA
+# SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+# Generates a project of UNITS translation units that each create a closure
+# with a distinct payload, once with #include <voidstar.h> and once with
+# import voidstar;, and reports the wall time of a clean build of each.
+#
+# Usage: cmake -DUNITS=<N> -DVOIDSTAR_SOURCE_DIR=<dir> -DWORK_DIR=<dir>
+#              -DGENERATOR=<generator> -DCOMPILER=<c++> [-DBUILD_TYPE=<type>]
+#              [-DJOBS=<N>] [-DMODES=header|module] -P measure.cmake
+
+if(NOT DEFINED UNITS
+   OR NOT DEFINED VOIDSTAR_SOURCE_DIR
+   OR NOT DEFINED WORK_DIR
+   OR NOT DEFINED GENERATOR
+   OR NOT DEFINED COMPILER)
+  message(
+    FATAL_ERROR
+      "UNITS, VOIDSTAR_SOURCE_DIR, WORK_DIR, GENERATOR and COMPILER must be defined"
+  )
+endif()
+
+if(NOT DEFINED MODES)
+  set(MODES header module)
+else()
+  string(REPLACE "|" ";" MODES "${MODES}")
+endif()
+
+if(NOT DEFINED JOBS)
+  set(JOBS 1)
+endif()
+
+if(NOT BUILD_TYPE)
+  set(BUILD_TYPE Release)
+endif()
+
+# Seconds since the epoch with sub-second precision where supported
+function(_now out)
+  if(CMAKE_VERSION VERSION_GREATER_EQUAL 3.23)
+    string(TIMESTAMP _seconds "%s")
+    string(TIMESTAMP _micros "%f")
+    set(${out} "${_seconds}${_micros}" PARENT_SCOPE)
+  else()
+    string(TIMESTAMP _seconds "%s")
+    set(${out} "${_seconds}000000" PARENT_SCOPE)
+  endif()
+endfunction()
+
+function(_generate mode dir)
+  if(mode STREQUAL "module")
+    set(_prologue "import voidstar;\n")
+    set(_minimum 3.28)
+    set(_target
+        "add_library(voidstar_module)
+target_sources(
+  voidstar_module
+  PUBLIC FILE_SET CXX_MODULES BASE_DIRS \"${VOIDSTAR_SOURCE_DIR}/module\"
+         FILES \"${VOIDSTAR_SOURCE_DIR}/module/voidstar.cppm\")
+target_include_directories(voidstar_module
+                           PUBLIC \"${VOIDSTAR_SOURCE_DIR}/include\")
+target_link_libraries(voidstar_module PUBLIC libffi::libffi)
+set(_voidstar voidstar_module)
+")
+  else()
+    set(_prologue "#include <voidstar.h>\n")
+    set(_minimum 3.22)
+    set(_target
+        "add_library(voidstar_headers INTERFACE)
+target_include_directories(voidstar_headers
+                           INTERFACE \"${VOIDSTAR_SOURCE_DIR}/include\")
+target_link_libraries(voidstar_headers INTERFACE libffi::libffi)
+set(_voidstar voidstar_headers)
+")
+  endif()
+
+  file(REMOVE_RECURSE "${dir}")
+
+  set(_sources "")
+  math(EXPR _last "${UNITS} - 1")
+  foreach(i RANGE ${_last})
+    file(
+      WRITE "${dir}/unit${i}.cpp"
+      "// Generated by measure.cmake. Do not edit.
+
+${_prologue}
+namespace {
+
+struct payload {
+  auto operator()(int x, double y) const -> int {
+    return x + static_cast<int>(y) + ${i};
+  }
+};
+
+} // namespace
+
+auto unit${i}() -> void * {
+  static voidstar::closure<int(int, double), payload> const cls{};
+  return reinterpret_cast<void *>(cls.get());
+}
+")
+    string(APPEND _sources " unit${i}.cpp")
+  endforeach()
+
+  file(
+    WRITE "${dir}/CMakeLists.txt"
+    "# Generated by measure.cmake. Do not edit.
+
+cmake_minimum_required(VERSION ${_minimum})
+project(voidstar_module_build_${mode} LANGUAGES CXX)
+
+set(CMAKE_CXX_STANDARD 20)
+set(CMAKE_CXX_STANDARD_REQUIRED True)
+set(CMAKE_CXX_EXTENSIONS False)
+
+list(APPEND CMAKE_MODULE_PATH \"${VOIDSTAR_SOURCE_DIR}/cmake\")
+find_package(libffi REQUIRED 3.0)
+
+${_target}
+add_library(units STATIC${_sources})
+target_link_libraries(units PRIVATE \${_voidstar})
+")
+endfunction()
+
+foreach(_mode IN LISTS MODES)
+  set(_source "${WORK_DIR}/${_mode}")
+  set(_build "${WORK_DIR}/${_mode}-build")
+
+  _generate(${_mode} "${_source}")
+  file(REMOVE_RECURSE "${_build}")
+
+  execute_process(
+    COMMAND
+      ${CMAKE_COMMAND} -S "${_source}" -B "${_build}" -G "${GENERATOR}"
+      -DCMAKE_CXX_COMPILER=${COMPILER} -DCMAKE_BUILD_TYPE=${BUILD_TYPE}
+    RESULT_VARIABLE _result
+    OUTPUT_QUIET
+    ERROR_VARIABLE _errors)
+  if(NOT _result EQUAL 0)
+    message(FATAL_ERROR "Configuring the ${_mode} project failed:\n${_errors}")
+  endif()
+
+  _now(_start)
+  execute_process(
+    COMMAND ${CMAKE_COMMAND} --build "${_build}" --parallel ${JOBS}
+    RESULT_VARIABLE _result
+    OUTPUT_VARIABLE _output
+    ERROR_VARIABLE _errors)
+  _now(_end)
+  if(NOT _result EQUAL 0)
+    message(
+      FATAL_ERROR "Building the ${_mode} project failed:\n${_output}${_errors}")
+  endif()
+
+  math(EXPR _ms "(${_end} - ${_start}) / 1000")
+  set(_${_mode}_ms ${_ms})
+  message(STATUS "${_mode}: ${UNITS} units built in ${_ms} ms")
+endforeach()
+
+if(DEFINED _header_ms
+   AND DEFINED _module_ms
+   AND _module_ms GREATER 0)
+  math(EXPR _percent "100 * ${_module_ms} / ${_header_ms}")
+  message(STATUS "module build takes ${_percent}% of the header build time")
+endif()
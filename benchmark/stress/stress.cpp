@@ -0,0 +1,442 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Throughput scaling and tail latency of closures under concurrent calls,
+// construction and destruction
+
+#include <voidstar.h>
+#include <voidstar/closure_pool.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/metrics.h>
+#include <voidstar/retirable_closure.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <latch>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace voidstar::stress {
+namespace {
+
+using clock = std::chrono::steady_clock;
+using signature = int(int);
+
+struct increment {
+  int step;
+  auto operator()(int x) const noexcept -> int { return x + step; }
+};
+
+/// @brief One in this many operations is timed individually.
+constexpr std::uint64_t sample_interval = 64;
+
+struct options {
+  unsigned max_threads = std::max(1U, std::thread::hardware_concurrency());
+  std::chrono::milliseconds duration{200};
+  std::string scenario = "all";
+  std::string kind = "all";
+  bool csv = false;
+};
+
+/// @brief What one worker thread measured; padded against false sharing.
+struct alignas(64) worker_result {
+  std::uint64_t operations = 0;
+  std::vector<std::uint32_t> latencies;
+};
+
+/// @brief Aggregated measurements of one role in one run.
+struct row {
+  std::string_view kind;
+  std::string_view scenario;
+  std::string_view role;
+  unsigned threads;
+  unsigned role_threads;
+  double ops_per_second;
+  std::uint32_t p50;
+  std::uint32_t p99;
+  std::uint32_t p999;
+  std::uint32_t max;
+};
+
+/// @brief A row of @a scenario and @a role without measurements yet.
+auto unmeasured_row(std::string_view scenario, std::string_view role,
+                    unsigned threads) -> row {
+  return row{
+      .kind = {},
+      .scenario = scenario,
+      .role = role,
+      .threads = threads,
+      .role_threads = 0,
+      .ops_per_second = 0.0,
+      .p50 = 0,
+      .p99 = 0,
+      .p999 = 0,
+      .max = 0,
+  };
+}
+
+auto nanoseconds_between(clock::time_point from, clock::time_point to)
+    -> std::uint32_t {
+  auto const elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+  return static_cast<std::uint32_t>(std::min<std::int64_t>(
+      elapsed, std::numeric_limits<std::uint32_t>::max()));
+}
+
+/**
+ * @brief Run @a operation in a loop until @a stop is set, timing every
+ * `sample_interval`-th call.
+ */
+template <typename O>
+void measure(std::atomic<bool> const &stop, worker_result &result,
+             O &&operation) {
+  std::uint64_t operations = 0;
+  while (not stop.load(std::memory_order_relaxed)) {
+    if (operations % sample_interval == 0) {
+      auto const start = clock::now();
+      operation();
+      result.latencies.push_back(nanoseconds_between(start, clock::now()));
+    } else {
+      operation();
+    }
+    operations++;
+  }
+  result.operations = operations;
+}
+
+/**
+ * @brief Start @a threads workers together, let them run for the configured
+ * duration and return what each measured.
+ *
+ * @a body is called as `body(index, stop, result)` on each worker.
+ */
+template <typename B>
+auto run_workers(options const &opts, unsigned threads, B const &body)
+    -> std::pair<std::vector<worker_result>, std::chrono::nanoseconds> {
+  std::vector<worker_result> results(threads);
+  for (auto &result : results) {
+    result.latencies.reserve(1 << 16);
+  }
+
+  std::atomic<bool> stop{false};
+  std::latch ready{static_cast<std::ptrdiff_t>(threads) + 1};
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (unsigned i = 0; i < threads; i++) {
+    workers.emplace_back([&, i] {
+      ready.arrive_and_wait();
+      body(i, stop, results[i]);
+    });
+  }
+
+  ready.arrive_and_wait();
+  auto const start = clock::now();
+  std::this_thread::sleep_for(opts.duration);
+  stop = true;
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto const elapsed = clock::now() - start;
+
+  return {std::move(results), elapsed};
+}
+
+/// @brief Merge the results of the workers for which @a selected is `true`.
+template <typename S>
+auto summarize(std::vector<worker_result> const &results,
+               std::chrono::nanoseconds elapsed, S const &selected,
+               row base) -> row {
+  std::uint64_t operations = 0;
+  std::vector<std::uint32_t> latencies;
+  unsigned role_threads = 0;
+
+  for (unsigned i = 0; i < results.size(); i++) {
+    if (not selected(i)) {
+      continue;
+    }
+    role_threads++;
+    operations += results[i].operations;
+    latencies.insert(latencies.end(), results[i].latencies.begin(),
+                     results[i].latencies.end());
+  }
+
+  std::sort(latencies.begin(), latencies.end());
+  auto const percentile = [&](double fraction) -> std::uint32_t {
+    if (latencies.empty()) {
+      return 0;
+    }
+    auto const index = static_cast<std::size_t>(
+        fraction * static_cast<double>(latencies.size() - 1));
+    return latencies[index];
+  };
+
+  base.role_threads = role_threads;
+  base.ops_per_second = static_cast<double>(operations) /
+                        std::chrono::duration<double>(elapsed).count();
+  base.p50 = percentile(0.5);
+  base.p99 = percentile(0.99);
+  base.p999 = percentile(0.999);
+  base.max = latencies.empty() ? 0 : latencies.back();
+  return base;
+}
+
+/// @brief All threads call the same closure.
+template <typename M>
+auto shared_calls(options const &opts, unsigned threads, M const &make)
+    -> std::vector<row> {
+  auto const cls = make();
+  auto const fn = cls.get();
+
+  auto const [results, elapsed] =
+      run_workers(opts, threads, [&](unsigned, auto &stop, auto &result) {
+        int x = 0;
+        measure(stop, result, [&] { x = fn(x); });
+        (void)x;
+      });
+
+  return {summarize(results, elapsed, [](unsigned) { return true; },
+                    unmeasured_row("shared", "call", threads))};
+}
+
+/// @brief Each thread calls a closure of its own.
+template <typename M>
+auto private_calls(options const &opts, unsigned threads, M const &make)
+    -> std::vector<row> {
+  auto const [results, elapsed] =
+      run_workers(opts, threads, [&](unsigned, auto &stop, auto &result) {
+        auto const cls = make();
+        auto const fn = cls.get();
+        int x = 0;
+        measure(stop, result, [&] { x = fn(x); });
+        (void)x;
+      });
+
+  return {summarize(results, elapsed, [](unsigned) { return true; },
+                    unmeasured_row("private", "call", threads))};
+}
+
+/**
+ * @brief Even threads construct, call once and destroy closures while odd
+ * threads call closures of their own.
+ */
+template <typename M>
+auto churn(options const &opts, unsigned threads, M const &make)
+    -> std::vector<row> {
+  auto const [results, elapsed] =
+      run_workers(opts, threads, [&](unsigned index, auto &stop, auto &result) {
+        int x = 0;
+        if (index % 2 == 0) {
+          measure(stop, result, [&] {
+            auto const cls = make();
+            x = cls.get()(x);
+          });
+        } else {
+          auto const cls = make();
+          auto const fn = cls.get();
+          measure(stop, result, [&] { x = fn(x); });
+        }
+        (void)x;
+      });
+
+  std::vector<row> rows{
+      summarize(results, elapsed, [](unsigned i) { return i % 2 == 0; },
+                unmeasured_row("churn", "create+call+destroy", threads)),
+  };
+  if (threads > 1) {
+    rows.push_back(
+        summarize(results, elapsed, [](unsigned i) { return i % 2 == 1; },
+                  unmeasured_row("churn", "call", threads)));
+  }
+  return rows;
+}
+
+/// @brief 1, 2, 4, ... up to and including @a max.
+auto thread_counts(unsigned max) -> std::vector<unsigned> {
+  std::vector<unsigned> counts;
+  for (unsigned count = 1; count < max; count *= 2) {
+    counts.push_back(count);
+  }
+  counts.push_back(max);
+  return counts;
+}
+
+void print_header(options const &opts) {
+  if (opts.csv) {
+    std::puts("kind,scenario,role,threads,role_threads,ops_per_second,"
+              "ops_per_second_per_thread,efficiency,p50_ns,p99_ns,p999_ns,"
+              "max_ns");
+  } else {
+    std::printf("%-20s %-8s %-20s %7s %14s %14s %6s %8s %8s %8s %10s\n",
+                "kind", "scenario", "role", "threads", "ops/s",
+                "ops/s/thread", "eff", "p50 ns", "p99 ns", "p99.9 ns",
+                "max ns");
+  }
+}
+
+/**
+ * @brief Print @a current; efficiency is the per-thread throughput relative to
+ * the single-thread run of the same role, and drops well below 1 where
+ * threads serialize.
+ */
+void print_row(options const &opts, row const &current,
+               std::optional<double> single_thread) {
+  auto const per_thread =
+      current.ops_per_second / static_cast<double>(current.role_threads);
+  auto const efficiency =
+      single_thread.has_value() ? per_thread / *single_thread : 1.0;
+
+  if (opts.csv) {
+    std::printf("%.*s,%.*s,%.*s,%u,%u,%.0f,%.0f,%.3f,%u,%u,%u,%u\n",
+                static_cast<int>(current.kind.size()), current.kind.data(),
+                static_cast<int>(current.scenario.size()),
+                current.scenario.data(),
+                static_cast<int>(current.role.size()), current.role.data(),
+                current.threads, current.role_threads, current.ops_per_second,
+                per_thread, efficiency, current.p50, current.p99, current.p999,
+                current.max);
+  } else {
+    std::printf("%-20.*s %-8.*s %-20.*s %7u %14.0f %14.0f %6.2f %8u %8u %8u "
+                "%10u\n",
+                static_cast<int>(current.kind.size()), current.kind.data(),
+                static_cast<int>(current.scenario.size()),
+                current.scenario.data(),
+                static_cast<int>(current.role.size()), current.role.data(),
+                current.threads, current.ops_per_second, per_thread,
+                efficiency, current.p50, current.p99, current.p999,
+                current.max);
+  }
+  std::fflush(stdout);
+}
+
+/// @brief Run the selected scenarios for closures created by @a make.
+template <typename M>
+void run_kind(options const &opts, std::string_view kind, M const &make) {
+  if (opts.kind != "all" and opts.kind != kind) {
+    return;
+  }
+
+  using scenario_fn = std::vector<row> (*)(options const &, unsigned,
+                                           M const &);
+  struct scenario {
+    std::string_view name;
+    scenario_fn run;
+  };
+  constexpr scenario scenarios[] = {
+      {"shared", &shared_calls<M>},
+      {"private", &private_calls<M>},
+      {"churn", &churn<M>},
+  };
+
+  for (auto const &[name, run] : scenarios) {
+    if (opts.scenario != "all" and opts.scenario != name) {
+      continue;
+    }
+
+    std::vector<double> single_thread;
+    for (auto const threads : thread_counts(opts.max_threads)) {
+      auto rows = run(opts, threads, make);
+      for (std::size_t i = 0; i < rows.size(); i++) {
+        rows[i].kind = kind;
+        auto const per_thread =
+            rows[i].ops_per_second / static_cast<double>(rows[i].role_threads);
+
+        // The baseline of a role is the first run that had it
+        std::optional<double> baseline;
+        if (i < single_thread.size()) {
+          baseline = single_thread[i];
+        } else {
+          single_thread.push_back(per_thread);
+        }
+        print_row(opts, rows[i], baseline);
+      }
+    }
+  }
+}
+
+auto parse(int argc, char *argv[]) -> std::optional<options> {
+  options opts;
+  for (int i = 1; i < argc; i++) {
+    std::string_view const arg = argv[i];
+    auto const value = [&](std::string_view prefix) -> std::optional<
+                                                        std::string_view> {
+      if (arg.starts_with(prefix)) {
+        return arg.substr(prefix.size());
+      }
+      return std::nullopt;
+    };
+
+    if (auto const threads = value("--threads=")) {
+      opts.max_threads = static_cast<unsigned>(
+          std::max(1L, std::strtol(std::string{*threads}.c_str(), nullptr,
+                                   10)));
+    } else if (auto const duration = value("--duration-ms=")) {
+      opts.duration = std::chrono::milliseconds{
+          std::max(1L, std::strtol(std::string{*duration}.c_str(), nullptr,
+                                   10))};
+    } else if (auto const scenario = value("--scenario=")) {
+      opts.scenario = *scenario;
+    } else if (auto const kind = value("--kind=")) {
+      opts.kind = *kind;
+    } else if (arg == "--csv") {
+      opts.csv = true;
+    } else {
+      std::fprintf(
+          stderr,
+          "Usage: %s [--threads=N] [--duration-ms=MS] "
+          "[--scenario=all|shared|private|churn]\n"
+          "          [--kind=all|closure|direct_closure|pooled_closure|"
+          "retirable_closure|instrumented_closure] [--csv]\n",
+          argv[0]);
+      return std::nullopt;
+    }
+  }
+  return opts;
+}
+
+} // namespace
+} // namespace voidstar::stress
+
+auto main(int argc, char *argv[]) -> int {
+  using namespace voidstar;
+  using namespace voidstar::stress;
+
+  auto const opts = parse(argc, argv);
+  if (not opts.has_value()) {
+    return 2;
+  }
+
+  if (not opts->csv) {
+    std::printf("voidstar %s, %u hardware threads, %lld ms per run\n\n",
+                VOIDSTAR_VERSION, std::thread::hardware_concurrency(),
+                static_cast<long long>(opts->duration.count()));
+  }
+  print_header(*opts);
+
+  run_kind(*opts, "closure",
+           [] { return closure<signature, increment>{1}; });
+  run_kind(*opts, "direct_closure",
+           [] { return direct_closure<signature, increment>{1}; });
+
+  closure_pool<signature> pool;
+  run_kind(*opts, "pooled_closure",
+           [&pool] { return make_closure<signature>(pool, increment{1}); });
+
+  run_kind(*opts, "retirable_closure",
+           [] { return make_retirable_closure<signature>(increment{1}); });
+  run_kind(*opts, "instrumented_closure",
+           [] { return make_instrumented_closure<signature>(increment{1}); });
+
+  wait_for_retired_closures();
+  return 0;
+}
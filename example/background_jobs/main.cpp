@@ -9,8 +9,8 @@
 
 #include <cstdlib>
 #include <iostream>
-#include <list>
 #include <string>
+#include <vector>
 
 static int get_job_count(int argc, char *argv[]) {
   if (argc != 2) {
@@ -36,19 +36,21 @@ int main(int argc, char *argv[]) {
     }
   };
 
-  // Shortcut for convenience
-  using closure = voidstar::closure<badlib_job_callback, the_callback>;
+  // Shortcut for convenience. unique_closure is a movable handle to a
+  // heap-allocated voidstar::closure, so it can be stored in a std::vector.
+  using closure = voidstar::unique_closure<badlib_job_callback, the_callback>;
 
   // Callbacks potentially in use.
   //
   // The C function pointer obtained via .get() is only usable while its source
   // voidstar::closure object is still alive. In this example, it is enough to
   // keep them around until badlib_join() returns.
-  std::list<closure> closures;
+  std::vector<closure> closures;
+  closures.reserve(jobs);
 
   // Start all jobs in the background
   for (int i = 0; i < jobs; i++) {
-    // Construct the i-th closure. The constructor of voidstar::closure
+    // Construct the i-th closure. The constructor of voidstar::unique_closure
     // allocates and writes the machine code for a new C function.
     closures.emplace_back(the_callback{i});
 
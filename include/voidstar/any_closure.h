@@ -0,0 +1,58 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_ANY_CLOSURE_H
+#define VOIDSTAR_ANY_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/any_payload.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/native/direct.h>
+
+#include <cstddef>
+
+namespace voidstar {
+
+/**
+ * @brief The default size of the inline buffer of
+ * [any_payload](#any_payload) and [any_closure](#any_closure).
+ *
+ * @since 1.0.0
+ */
+inline constexpr std::size_t default_any_buffer_size =
+    detail::default_any_buffer_size;
+
+/**
+ * @brief A copyable type-erased payload for call signature @a F that can hold
+ * any copyable callable matching @a F.
+ *
+ * Callables of at most @a N bytes that are nothrow-movable are stored inline;
+ * larger ones are allocated on the heap. A call is one indirect call into the
+ * held callable.
+ *
+ * @since 1.0.0
+ */
+template <typename F, std::size_t N = default_any_buffer_size>
+using any_payload = detail::any_payload<detail::call_signature<F>, N>;
+
+/**
+ * @brief A closure with call signature @a F whose payload may be any copyable
+ * callable matching @a F, so that closures with different callables share a
+ * type.
+ *
+ * Construct from the callable, as in `any_closure<F>{lambda}`. The callable is
+ * held in an [any_payload](#any_payload), without `std::function` in between.
+ * Like [direct_closure](#direct_closure), the trampoline avoids libffi where
+ * the call signature allows it.
+ *
+ * @since 1.0.0
+ */
+template <typename F, std::size_t N = default_any_buffer_size>
+using any_closure = detail::closure_impl<
+    detail::call_signature<F>, any_payload<F, N>,
+    detail::native::direct_or_ffi_trampoline<detail::call_signature<F>>,
+    detail::default_call_hooks<detail::call_signature<F>, any_payload<F, N>>>;
+
+} // namespace voidstar
+
+#endif
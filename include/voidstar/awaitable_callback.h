@@ -0,0 +1,68 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_AWAITABLE_CALLBACK_H
+#define VOIDSTAR_AWAITABLE_CALLBACK_H
+
+#include <voidstar/closure_pool.h>
+#include <voidstar/detail/awaitable_callback.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/ffi/closure_pool.h>
+
+namespace voidstar {
+
+/**
+ * @brief Executor of [awaitable_callback](#awaitable_callback) that resumes
+ * the awaiting coroutine on the thread that invoked the callback.
+ *
+ * @since 1.0.0
+ */
+using resume_inline = detail::resume_inline;
+
+/**
+ * @brief A C function pointer that, when called, resumes the coroutine that
+ * awaits this object.
+ *
+ * `co_await` evaluates to nothing, the only argument, or a `std::tuple` of
+ * all arguments of the call. The callback may be invoked before it is
+ * awaited, in which case the coroutine does not suspend. It must be invoked
+ * at most once per `co_await`; the object may be awaited repeatedly and keeps
+ * its function pointer. Non-void callbacks return a value-initialized result.
+ *
+ * The coroutine may destroy this object while the callback is still resuming
+ * it, e.g. by finishing. Call hooks such as `VOIDSTAR_CLOSURE_METRICS` do not
+ * apply to it, since they would outlive the object.
+ *
+ * @tparam F The call signature of the callback; either a function type or a
+ * pointer to function type.
+ *
+ * @tparam E Invoked with the `std::coroutine_handle<>` of the suspended
+ * coroutine to resume it, for example by posting it to an event loop. An
+ * executor that resumes the coroutine before returning must not access
+ * itself afterwards: the coroutine may already have destroyed the callback.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::coroutine_executor E = resume_inline>
+using awaitable_callback =
+    detail::awaitable_callback_impl<detail::call_signature<F>,
+                                    detail::ffi::closure, E>;
+
+/**
+ * @brief An [awaitable_callback](#awaitable_callback) whose trampoline is
+ * borrowed from a [closure_pool](#closure_pool).
+ *
+ * Construct with `pooled_awaitable_callback<F>{pool}` or
+ * `pooled_awaitable_callback<F, E>{pool, executor}`.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::coroutine_executor E = resume_inline>
+using pooled_awaitable_callback = detail::awaitable_callback_impl<
+    detail::call_signature<F>,
+    detail::ffi::pooled_trampoline<closure_pool<F>>, E>;
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,79 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_BANKED_CLOSURE_H
+#define VOIDSTAR_BANKED_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/static_bank.h>
+
+#include <cstddef>
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief The number of banked closures of one signature that may exist at
+ * once unless specified otherwise.
+ *
+ * @since 1.0.0
+ */
+inline constexpr std::size_t default_bank_capacity = 64;
+
+/**
+ * @brief Thrown when a [banked_closure](#banked_closure) is constructed while
+ * all slots of its bank are in use.
+ *
+ * @since 1.0.0
+ */
+using bank_exhausted_error = detail::bank_exhausted_error;
+
+/**
+ * @brief A [closure](#closure) whose C function is one of @a N functions
+ * compiled ahead of time for call signature @a F.
+ *
+ * No executable memory is allocated or written at runtime. At most @a N
+ * banked closures with the same @a F and @a N may exist at once; constructing
+ * another one throws `bank_exhausted_error` without constructing the payload.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P,
+          std::size_t N = default_bank_capacity>
+using banked_closure = detail::closure_impl<
+    detail::call_signature<F>, P,
+    detail::bank_trampoline<detail::call_signature<F>, N>,
+    detail::default_call_hooks<detail::call_signature<F>, P>>;
+
+/**
+ * @brief Constructs a new [banked_closure](#banked_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @param payload The object to invoke through the C function pointer. It is
+ * moved into the closure.
+ *
+ * @throws bank_exhausted_error if all @a N slots are in use.
+ *
+ * @since 1.0.0
+ */
+template <typename F, std::size_t N = default_bank_capacity,
+          detail::matches<detail::call_signature<F>> P>
+auto make_banked_closure(P payload) -> banked_closure<F, P, N> {
+  return banked_closure<F, P, N>{std::move(payload)};
+}
+
+/**
+ * @brief The number of [banked_closures](#banked_closure) with call signature
+ * @a F and capacity @a N that currently exist.
+ *
+ * @since 1.0.0
+ */
+template <typename F, std::size_t N = default_bank_capacity>
+[[nodiscard]] auto banked_closures_in_use() noexcept -> std::size_t {
+  return detail::static_bank<detail::call_signature<F>, N>::in_use();
+}
+
+} // namespace voidstar
+
+#endif
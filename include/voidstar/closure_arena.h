@@ -0,0 +1,44 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_CLOSURE_ARENA_H
+#define VOIDSTAR_CLOSURE_ARENA_H
+
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/closure_arena.h>
+
+namespace voidstar {
+
+/**
+ * @brief Tuning parameters of a [closure_arena](#closure_arena).
+ *
+ * @since 1.0.0
+ */
+using closure_arena_options = detail::closure_arena_options;
+
+/**
+ * @brief A bump allocator for closures of any call signature and payload type
+ * that are released all at once.
+ *
+ * Create closures with `arena.make<F>(payload)` or
+ * `arena.emplace<F, P>(payload-args...)`; both return a reference to an
+ * [arena_closure](#arena_closure). All closures are destroyed by `release()`
+ * or by the destructor of the arena.
+ *
+ * @since 1.0.0
+ */
+using closure_arena = detail::closure_arena;
+
+/**
+ * @brief The type of closures created by a [closure_arena](#closure_arena).
+ *
+ * Provides the same members as [closure](#closure).
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using arena_closure = detail::arena_closure<detail::call_signature<F>, P>;
+
+} // namespace voidstar
+
+#endif
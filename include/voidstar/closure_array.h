@@ -0,0 +1,277 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_CLOSURE_ARRAY_H
+#define VOIDSTAR_CLOSURE_ARRAY_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/native/executable_memory.h>
+
+#include <ffi.h>
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+namespace voidstar {
+
+namespace detail {
+
+/**
+ * @brief Implementation of voidstar::closure_array - a fixed number of
+ * closures with contiguous payloads and contiguous trampolines.
+ *
+ * @tparam C A `voidstar::detail::call_signature` struct describing the call
+ * signature of the trampolines.
+ *
+ * @tparam P User payload.
+ */
+template <typename C, matches<C> P> class closure_array_impl {
+public:
+  /**
+   * @brief Trampoline call signature.
+   *
+   * This is an implementation detail of voidstar. Do not use to ensure
+   * backwards compatibility.
+   */
+  using call_signature = C;
+
+  /// @brief Type of the payload objects.
+  using payload_type = P;
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+  /// @brief Type of the elements.
+  using value_type = closure_impl<C, P, ffi::placed_closure,
+                                  default_call_hooks<C, P>>;
+#else
+  /// @brief Type of the elements.
+  using value_type =
+      closure_impl<C, P, ffi::closure, default_call_hooks<C, P>>;
+#endif
+
+  /// @brief Type of the function pointers to the generated C functions.
+  using fn_ptr_type = typename value_type::fn_ptr_type;
+
+  using iterator = value_type *;
+  using const_iterator = value_type const *;
+
+private:
+  /// @brief Distance between trampolines; one cache line each.
+  static constexpr std::size_t trampoline_stride = 64;
+
+  static_assert(sizeof(ffi_closure) <= trampoline_stride);
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+  native::executable_block m_trampolines;
+#endif
+
+  value_type *m_closures = nullptr;
+  std::size_t m_size = 0;
+
+public:
+  /**
+   * @brief Create @a count closures, constructing each payload from @a args.
+   *
+   * @throws Any exception thrown by a payload constructor.
+   * @throws voidstar::error - if the C functions could not be generated.
+   */
+  template <typename... A>
+  requires std::constructible_from<P, A const &...>
+  explicit closure_array_impl(std::size_t count, A const &...args) {
+    construct(count, [&](std::size_t i) { emplace(i, args...); });
+  }
+
+  /**
+   * @brief Create a closure for every element of @a payloads, constructing
+   * each payload from the element.
+   *
+   * @throws Any exception thrown by a payload constructor.
+   * @throws voidstar::error - if the C functions could not be generated.
+   */
+  template <std::ranges::forward_range R>
+  requires std::constructible_from<P, std::ranges::range_reference_t<R>>
+  explicit closure_array_impl(R &&payloads) {
+    auto it = std::ranges::begin(payloads);
+    construct(static_cast<std::size_t>(std::ranges::distance(payloads)),
+              [&](std::size_t i) { emplace(i, *it++); });
+  }
+
+  closure_array_impl(closure_array_impl const &) = delete;
+  auto operator=(closure_array_impl const &) -> closure_array_impl & = delete;
+
+  /// @brief Moving an array does not move the closures.
+  closure_array_impl(closure_array_impl &&other) noexcept
+      :
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+        m_trampolines{std::move(other.m_trampolines)},
+#endif
+        m_closures{std::exchange(other.m_closures, nullptr)},
+        m_size{std::exchange(other.m_size, 0)} {
+  }
+
+  /// @brief Moving an array does not move the closures.
+  auto operator=(closure_array_impl &&other) noexcept
+      -> closure_array_impl & {
+    closure_array_impl moved{std::move(other)};
+    swap(moved);
+    return *this;
+  }
+
+  /// @brief Destroy all closures and free their memory at once.
+  ~closure_array_impl() { destroy(m_closures, m_size, m_size); }
+
+  /// @brief The number of closures.
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+  /// @brief `true` if there are no closures.
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+  /// @brief The closure at @a index.
+  [[nodiscard]] auto operator[](std::size_t index) noexcept -> value_type & {
+    return m_closures[index];
+  }
+
+  /// @brief The closure at @a index.
+  [[nodiscard]] auto operator[](std::size_t index) const noexcept
+      -> value_type const & {
+    return m_closures[index];
+  }
+
+  /// @brief The function pointer of the closure at @a index.
+  [[nodiscard]] auto get(std::size_t index) const noexcept -> fn_ptr_type {
+    return m_closures[index].get();
+  }
+
+  [[nodiscard]] auto begin() noexcept -> iterator { return m_closures; }
+  [[nodiscard]] auto end() noexcept -> iterator { return m_closures + m_size; }
+
+  [[nodiscard]] auto begin() const noexcept -> const_iterator {
+    return m_closures;
+  }
+
+  [[nodiscard]] auto end() const noexcept -> const_iterator {
+    return m_closures + m_size;
+  }
+
+private:
+  void swap(closure_array_impl &other) noexcept {
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+    std::swap(m_trampolines, other.m_trampolines);
+#endif
+    std::swap(m_closures, other.m_closures);
+    std::swap(m_size, other.m_size);
+  }
+
+  /**
+   * @brief Allocate memory for @a count closures and call @a emplace_at for
+   * every index.
+   */
+  template <typename E> void construct(std::size_t count, E &&emplace_at) {
+    if (count == 0) {
+      return;
+    }
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+    auto const code_size = count * trampoline_stride;
+    // Large arrays are worth a few iTLB entries less on the call path
+    m_trampolines = native::executable_block{
+        code_size, {.huge_pages = code_size >= native::huge_page_size}};
+#endif
+    auto *const closures = std::allocator<value_type>{}.allocate(count);
+    m_closures = closures;
+
+    std::size_t constructed = 0;
+    try {
+      for (; constructed < count; constructed++) {
+        emplace_at(constructed);
+      }
+    } catch (...) {
+      m_closures = nullptr;
+      destroy(closures, constructed, count);
+      throw;
+    }
+
+    m_size = count;
+  }
+
+  /// @brief Construct the closure at @a index from @a payload_args.
+  template <typename... A> void emplace(std::size_t index, A &&...payload_args) {
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+    auto const offset = index * trampoline_stride;
+    ffi::closure_location location{
+        .writable =
+            reinterpret_cast<ffi_closure *>(m_trampolines.writable() + offset),
+        .executable =
+            static_cast<std::byte *>(m_trampolines.executable()) + offset,
+    };
+    std::construct_at(m_closures + index, location,
+                      std::forward<A>(payload_args)...);
+#else
+    std::construct_at(m_closures + index, std::forward<A>(payload_args)...);
+#endif
+  }
+
+  /// @brief Destroy @a constructed closures in reverse order and free memory
+  /// for @a capacity closures.
+  static void destroy(value_type *closures, std::size_t constructed,
+                      std::size_t capacity) noexcept {
+    if (closures == nullptr) {
+      return;
+    }
+    for (std::size_t i = constructed; i > 0; i--) {
+      std::destroy_at(closures + i - 1);
+    }
+    std::allocator<value_type>{}.deallocate(closures, capacity);
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief A fixed number of [closures](#closure) with the same call signature
+ * and payload type, created and destroyed together.
+ *
+ * All payloads are stored in one contiguous array. Where executable memory
+ * can be mapped directly, all trampolines are placed in one contiguous block
+ * as well.
+ *
+ * @tparam F The desired call signature of the trampolines; either a function
+ * type or a pointer to function type.
+ *
+ * @tparam P A user-provided callable payload that should be invoked by the
+ * trampolines.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using closure_array = detail::closure_array_impl<detail::call_signature<F>, P>;
+
+/**
+ * @brief Constructs a [closure_array](#closure_array) with one closure per
+ * element of @a payloads, deducing the payload type automatically.
+ *
+ * @tparam F The desired call signature of the trampolines; either a function
+ * type or a pointer to function type.
+ *
+ * @param payloads A forward range of payloads. Each closure's payload is
+ * constructed from the corresponding element.
+ *
+ * @since 1.0.0
+ */
+template <typename F, std::ranges::forward_range R>
+requires detail::matches<std::ranges::range_value_t<R>,
+                         detail::call_signature<F>>
+auto make_closures(R &&payloads)
+    -> closure_array<F, std::ranges::range_value_t<R>> {
+  return closure_array<F, std::ranges::range_value_t<R>>{
+      std::forward<R>(payloads)};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,208 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_CLOSURE_HANDLE_H
+#define VOIDSTAR_CLOSURE_HANDLE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+
+#include <concepts>
+#include <memory>
+#include <utility>
+
+namespace voidstar {
+
+namespace detail {
+
+/**
+ * @brief Accessors shared by closure handles.
+ *
+ * @tparam derived A CRTP parameter; must provide `closure_ptr()` that returns a
+ * pointer to the managed closure or `nullptr`.
+ *
+ * @tparam C The closure type.
+ */
+template <typename derived, typename C> class closure_handle_base {
+public:
+  /**
+   * @brief Trampoline call signature.
+   *
+   * This is an implementation detail of voidstar. Do not use to ensure
+   * backwards compatibility.
+   */
+  using call_signature = typename C::call_signature;
+
+  /// @brief Type of the payload object.
+  using payload_type = typename C::payload_type;
+
+  /// @brief Type of the function pointer to the generated C function.
+  using fn_ptr_type = typename C::fn_ptr_type;
+
+  /**
+   * @brief Obtain a function pointer to the trampoline of the managed closure,
+   * or `nullptr` if the handle is empty.
+   */
+  [[nodiscard]] auto get() const noexcept -> fn_ptr_type {
+    auto const *const cls = self().closure_ptr();
+    return cls == nullptr ? nullptr : cls->get();
+  }
+
+  /**
+   * @brief Obtain a function pointer to the trampoline of the managed closure,
+   * or `nullptr` if the handle is empty.
+   */
+  operator fn_ptr_type() const noexcept { return get(); }
+
+  /// @brief `true` if the handle manages a closure.
+  explicit operator bool() const noexcept {
+    return self().closure_ptr() != nullptr;
+  }
+
+  /**
+   * @brief Get a mutable reference to the payload object of the managed
+   * closure. The handle must not be empty.
+   */
+  [[nodiscard]] auto payload() noexcept -> payload_type & {
+    return self().closure_ptr()->payload();
+  }
+
+  /**
+   * @brief Get a const reference to the payload object of the managed closure.
+   * The handle must not be empty.
+   */
+  [[nodiscard]] auto payload() const noexcept -> payload_type const & {
+    return self().closure_ptr()->payload();
+  }
+
+private:
+  [[nodiscard]] auto self() noexcept -> derived & {
+    return static_cast<derived &>(*this);
+  }
+
+  [[nodiscard]] auto self() const noexcept -> derived const & {
+    return static_cast<derived const &>(*this);
+  }
+};
+
+/**
+ * @brief A movable owning handle to a heap-allocated closure @a C.
+ *
+ * The closure itself never moves, so its trampoline stays valid when the
+ * handle is moved.
+ */
+template <typename C>
+class unique_handle : public closure_handle_base<unique_handle<C>, C> {
+private:
+  friend closure_handle_base<unique_handle<C>, C>;
+
+  std::unique_ptr<C> m_closure;
+
+  [[nodiscard]] auto closure_ptr() const noexcept -> C * {
+    return m_closure.get();
+  }
+
+public:
+  /**
+   * @brief Allocate a closure, forwarding @a args to its constructor.
+   *
+   * @throws Any exception thrown by the closure constructor or by `new`.
+   */
+  template <typename... A>
+  requires std::constructible_from<C, A...>
+  explicit unique_handle(A &&...args)
+      : m_closure{std::make_unique<C>(std::forward<A>(args)...)} {}
+
+  unique_handle(unique_handle &&) noexcept = default;
+  auto operator=(unique_handle &&) noexcept -> unique_handle & = default;
+
+  /// @brief Destroy the managed closure, leaving the handle empty.
+  void reset() noexcept { m_closure.reset(); }
+};
+
+/**
+ * @brief A copyable reference-counted handle to a heap-allocated closure @a C.
+ *
+ * The closure is destroyed when the last handle is destroyed or reset.
+ */
+template <typename C>
+class shared_handle : public closure_handle_base<shared_handle<C>, C> {
+private:
+  friend closure_handle_base<shared_handle<C>, C>;
+
+  std::shared_ptr<C> m_closure;
+
+  [[nodiscard]] auto closure_ptr() const noexcept -> C * {
+    return m_closure.get();
+  }
+
+public:
+  /**
+   * @brief Allocate a closure, forwarding @a args to its constructor.
+   *
+   * The closure and the reference counts share one allocation.
+   *
+   * @throws Any exception thrown by the closure constructor or by `new`.
+   */
+  template <typename... A>
+  requires std::constructible_from<C, A...>
+  explicit shared_handle(A &&...args)
+      : m_closure{std::make_shared<C>(std::forward<A>(args)...)} {}
+
+  shared_handle(shared_handle const &) noexcept = default;
+  auto operator=(shared_handle const &) noexcept -> shared_handle & = default;
+  shared_handle(shared_handle &&) noexcept = default;
+  auto operator=(shared_handle &&) noexcept -> shared_handle & = default;
+
+  /// @brief Release this reference, leaving the handle empty.
+  void reset() noexcept { m_closure.reset(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief A nothrow-movable owning handle to a heap-allocated
+ * [closure](#closure).
+ *
+ * Moving the handle does not move the closure, so the C function pointer
+ * remains valid. Suitable for contiguous containers such as `std::vector`.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using unique_closure = detail::unique_handle<closure<F, P>>;
+
+/**
+ * @brief A copyable reference-counted handle to a heap-allocated
+ * [closure](#closure).
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using shared_closure = detail::shared_handle<closure<F, P>>;
+
+/**
+ * @brief Constructs a new [unique_closure](#unique_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_unique_closure(P payload) -> unique_closure<F, P> {
+  return unique_closure<F, P>{std::move(payload)};
+}
+
+/**
+ * @brief Constructs a new [shared_closure](#shared_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_shared_closure(P payload) -> shared_closure<F, P> {
+  return shared_closure<F, P>{std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,75 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_CLOSURE_POOL_H
+#define VOIDSTAR_CLOSURE_POOL_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure_pool.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief Tuning parameters of a [closure_pool](#closure_pool).
+ *
+ * @since 1.0.0
+ */
+using closure_pool_options = detail::ffi::closure_pool_options;
+
+/**
+ * @brief A free list of prepared trampolines with call signature @a F.
+ *
+ * Trampolines are allocated and prepared ahead of time and recycled when
+ * closures built from the pool are destroyed. The pool must outlive all
+ * closures built from it.
+ *
+ * @tparam F The call signature of the trampolines; either a function type or a
+ * pointer to function type.
+ *
+ * @since 1.0.0
+ */
+template <typename F>
+using closure_pool = detail::ffi::closure_pool<detail::call_signature<F>>;
+
+/**
+ * @brief A [closure](#closure) whose trampoline is borrowed from a
+ * [closure_pool](#closure_pool).
+ *
+ * Construct with `pooled_closure<F, P>{pool, payload-args...}`.
+ *
+ * @tparam F The desired call signature of the trampoline; either a function
+ * type or a pointer to function type.
+ *
+ * @tparam P A user-provided callable payload that should be invoked by the
+ * trampoline.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using pooled_closure = detail::closure_impl<
+    detail::call_signature<F>, P,
+    detail::ffi::pooled_trampoline<closure_pool<F>>>;
+
+/**
+ * @brief Constructs a new [pooled_closure](#pooled_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @param pool The pool to borrow the trampoline from.
+ * @param payload The object to invoke through the C function pointer. It is
+ * moved into the closure.
+ *
+ * @return Initialized closure containing a move-constructed payload.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_closure(closure_pool<F> &pool, P payload) -> pooled_closure<F, P> {
+  return pooled_closure<F, P>{pool, std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
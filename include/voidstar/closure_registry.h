@@ -0,0 +1,110 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_CLOSURE_REGISTRY_H
+#define VOIDSTAR_CLOSURE_REGISTRY_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/closure_registry.h>
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief What [find_closure](#find_closure) knows about a live registered
+ * closure: its entry point, the size of its trampoline, the closure object,
+ * and the `std::type_index` of its function pointer and payload types.
+ *
+ * @since 1.0.0
+ */
+using closure_info = detail::closure_info;
+
+/**
+ * @brief A closure of type @a C that can be found with
+ * [find_closure](#find_closure) from the moment it is constructed until it is
+ * destroyed.
+ *
+ * Registration and unregistration take a process-wide mutex and are O(log n)
+ * in the number of registered closures. Closures that are not registered cost
+ * nothing.
+ *
+ * @tparam C A closure type such as [closure](#closure) or
+ * [direct_closure](#direct_closure) that has a trampoline of its own;
+ * [stateless_closure](#stateless_closure) cannot be registered.
+ *
+ * @since 1.0.0
+ */
+template <typename C> using registered = detail::registered<C>;
+
+/**
+ * @brief A [closure](#closure) that can be found with
+ * [find_closure](#find_closure).
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using registered_closure = registered<closure<F, P>>;
+
+/**
+ * @brief Constructs a new [registered_closure](#registered_closure) deducing
+ * the payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_registered_closure(P payload) -> registered_closure<F, P> {
+  return registered_closure<F, P>{std::move(payload)};
+}
+
+/**
+ * @brief Find the live registered closure whose trampoline contains
+ * @a address, such as a function pointer or a return address inside it.
+ *
+ * Lookups are O(log n) searches of an immutable index. They never lock or
+ * allocate, so they may run concurrently with registration.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto find_closure(void const *address) noexcept
+    -> std::optional<closure_info> {
+  return detail::closure_registry::instance().find(address);
+}
+
+/**
+ * @brief Find the live registered closure that @a fn_ptr points to.
+ *
+ * @since 1.0.0
+ */
+template <typename R, typename... A>
+[[nodiscard]] auto find_closure(R (*fn_ptr)(A...)) noexcept
+    -> std::optional<closure_info> {
+  return find_closure(reinterpret_cast<void const *>(fn_ptr));
+}
+
+/**
+ * @brief `true` if the closure described by @a info has not been destroyed,
+ * even if another closure now occupies the same address.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto is_live(closure_info const &info) noexcept -> bool {
+  auto const current = find_closure(info.entry_point);
+  return current.has_value() and current->id == info.id;
+}
+
+/**
+ * @brief The number of live registered closures.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto registered_closure_count() -> std::size_t {
+  return detail::closure_registry::instance().size();
+}
+
+} // namespace voidstar
+
+#endif
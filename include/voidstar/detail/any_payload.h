@@ -0,0 +1,189 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_ANY_PAYLOAD_H
+#define VOIDSTAR_DETAIL_ANY_PAYLOAD_H
+
+#include <voidstar/detail/call_signature.h>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar::detail {
+
+/// @brief The default size of the inline buffer of an `any_payload`.
+inline constexpr std::size_t default_any_buffer_size = 4 * sizeof(void *);
+
+/**
+ * @brief A copyable payload of call signature @a C that holds any copyable
+ * payload matching @a C.
+ *
+ * Payloads that fit into @a N bytes, are not overaligned and are nothrow
+ * move-constructible are stored inline; others are allocated on the heap.
+ * Calls go through a single function pointer stored in the object, which
+ * receives the address of the held payload.
+ *
+ * @tparam C Call signature.
+ * @tparam N The size of the inline buffer.
+ */
+template <typename C, std::size_t N = default_any_buffer_size,
+          typename arg_types = typename C::arg_types>
+class any_payload;
+
+template <typename C, std::size_t N, typename... A>
+class any_payload<C, N, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  using invoke_type = auto(void *object, A... args) -> return_type;
+
+  /// @brief Lifetime operations of the held payload.
+  struct vtable {
+    void (*destroy)(void *object) noexcept;
+    void (*copy)(void const *object, any_payload &into);
+    void (*move)(void *object, any_payload &into) noexcept;
+  };
+
+  template <typename P>
+  static constexpr bool stored_inline =
+      sizeof(P) <= N and alignof(P) <= alignof(std::max_align_t) and
+      std::is_nothrow_move_constructible_v<P>;
+
+  template <typename P> struct operations {
+    static auto invoke(void *object, A... args) -> return_type {
+      return static_cast<return_type>(
+          std::invoke(*static_cast<P *>(object), args...));
+    }
+
+    static void destroy(void *object) noexcept {
+      if constexpr (stored_inline<P>) {
+        std::destroy_at(static_cast<P *>(object));
+      } else {
+        delete static_cast<P *>(object);
+      }
+    }
+
+    static void copy(void const *object, any_payload &into) {
+      into.template emplace<P>(*static_cast<P const *>(object));
+    }
+
+    static void move(void *object, any_payload &into) noexcept {
+      if constexpr (stored_inline<P>) {
+        into.template emplace<P>(std::move(*static_cast<P *>(object)));
+        std::destroy_at(static_cast<P *>(object));
+      } else {
+        // Heap payloads change owners without being moved
+        into.m_object = object;
+        into.m_invoke = &invoke;
+        into.m_vtable = &table;
+      }
+    }
+
+    static constexpr vtable table{&destroy, &copy, &move};
+  };
+
+  invoke_type *m_invoke = nullptr;
+  vtable const *m_vtable = nullptr;
+  void *m_object = nullptr;
+  alignas(std::max_align_t) std::byte m_buffer[N];
+
+public:
+  /// @brief `true` if payloads of type @a P are stored without allocation.
+  template <typename P>
+  static constexpr bool is_stored_inline = stored_inline<P>;
+
+  /**
+   * @brief Hold a copy of @a payload.
+   *
+   * @throws Any exception thrown by the payload constructor.
+   * @throws std::bad_alloc if the payload is stored on the heap and could not
+   * be allocated.
+   */
+  template <typename P>
+  requires(not std::same_as<std::remove_cvref_t<P>, any_payload>) and
+          matches<std::decay_t<P>, C> and
+          std::copy_constructible<std::decay_t<P>>
+  any_payload(P &&payload) {
+    emplace<std::decay_t<P>>(std::forward<P>(payload));
+  }
+
+  /**
+   * @brief Hold a @a P constructed from @a args.
+   *
+   * @throws Any exception thrown by the payload constructor.
+   * @throws std::bad_alloc if the payload is stored on the heap and could not
+   * be allocated.
+   */
+  template <typename P, typename... S>
+  requires matches<P, C> and std::copy_constructible<P> and
+           std::constructible_from<P, S...>
+  explicit any_payload(std::in_place_type_t<P>, S &&...args) {
+    emplace<P>(std::forward<S>(args)...);
+  }
+
+  /// @brief Copy the held payload.
+  any_payload(any_payload const &other) {
+    other.m_vtable->copy(other.m_object, *this);
+  }
+
+  /// @brief Take the held payload; @a other may only be destroyed afterwards.
+  any_payload(any_payload &&other) noexcept {
+    other.m_vtable->move(other.m_object, *this);
+    other.m_vtable = nullptr;
+  }
+
+  auto operator=(any_payload const &) -> any_payload & = delete;
+  auto operator=(any_payload &&) -> any_payload & = delete;
+
+  ~any_payload() {
+    if (m_vtable != nullptr) {
+      m_vtable->destroy(m_object);
+    }
+  }
+
+  /// @brief Invoke the held payload.
+  auto operator()(A... args) const -> return_type {
+    return m_invoke(m_object, std::move(args)...);
+  }
+
+  /// @brief The held payload if it is a @a P, otherwise `nullptr`.
+  template <typename P> [[nodiscard]] auto target() noexcept -> P * {
+    return m_vtable == &operations<P>::table ? static_cast<P *>(m_object)
+                                             : nullptr;
+  }
+
+  /// @brief The held payload if it is a @a P, otherwise `nullptr`.
+  template <typename P>
+  [[nodiscard]] auto target() const noexcept -> P const * {
+    return m_vtable == &operations<P>::table
+               ? static_cast<P const *>(m_object)
+               : nullptr;
+  }
+
+  /// @brief `true` if the held payload is stored on the heap.
+  [[nodiscard]] auto is_heap_allocated() const noexcept -> bool {
+    return m_object != static_cast<void const *>(m_buffer);
+  }
+
+private:
+  template <typename P, typename... S> void emplace(S &&...args) {
+    if constexpr (stored_inline<P>) {
+      m_object = ::new (static_cast<void *>(m_buffer))
+          P(std::forward<S>(args)...);
+    } else {
+      m_object = new P(std::forward<S>(args)...);
+    }
+    m_invoke = &operations<P>::invoke;
+    m_vtable = &operations<P>::table;
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
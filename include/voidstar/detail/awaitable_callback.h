@@ -0,0 +1,204 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_AWAITABLE_CALLBACK_H
+#define VOIDSTAR_DETAIL_AWAITABLE_CALLBACK_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_hooks.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <functional>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar::detail {
+
+/// @brief Resumes coroutines on the thread that invoked the callback.
+struct resume_inline {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/// @brief Something that can schedule the resumption of a coroutine.
+template <typename E>
+concept coroutine_executor = std::invocable<E &, std::coroutine_handle<>>;
+
+/// @brief What `co_await` on a callback with arguments @a A evaluates to.
+template <typename... A> struct await_result {
+  using type = std::tuple<A...>;
+};
+
+template <> struct await_result<> {
+  using type = void;
+};
+
+template <typename A> struct await_result<A> {
+  using type = A;
+};
+
+/**
+ * @brief A C callback that resumes the coroutine awaiting it.
+ *
+ * The arguments of the callback are stored in this object, which normally
+ * lives in the frame of the awaiting coroutine, so no memory is allocated
+ * besides the trampoline. The trampoline is kept across awaits.
+ *
+ * @tparam C Call signature of the callback.
+ * @tparam T Trampoline implementation.
+ * @tparam E Executor invoked with the coroutine handle to resume it.
+ */
+template <typename C, ffi::trampoline T, coroutine_executor E,
+          typename arg_types = typename C::arg_types>
+class awaitable_callback_impl;
+
+template <typename C, ffi::trampoline T, coroutine_executor E, typename... A>
+class awaitable_callback_impl<C, T, E, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  /**
+   * @brief The payload of the trampoline.
+   *
+   * Resuming the coroutine may destroy its frame and with it this object and
+   * the trampoline that is still executing. Nothing here touches the owner
+   * after the executor has been invoked.
+   */
+  struct completion {
+    awaitable_callback_impl *owner;
+
+    auto operator()(A... args) const -> return_type {
+      owner->complete(std::move(args)...);
+      if constexpr (not std::is_void_v<return_type>) {
+        return return_type{};
+      }
+    }
+  };
+
+  // Call hooks would run their scope exit after the frame is destroyed
+  using closure_type = closure_impl<C, completion, T, no_call_hooks>;
+
+  static constexpr bool nothrow_get =
+      noexcept(std::declval<closure_type const &>().get());
+
+  [[no_unique_address]] E m_executor;
+
+  std::optional<std::tuple<A...>> m_arguments;
+
+  /// @brief `nullptr` while pending, `completed_marker()` once the callback
+  /// ran, otherwise the address of the suspended coroutine.
+  std::atomic<void *> m_state{nullptr};
+
+  closure_type m_closure;
+
+public:
+  /// @brief Type of the function pointer to hand to C code.
+  using fn_ptr_type = typename C::fn_ptr_type;
+
+  /// @brief What `co_await` evaluates to.
+  using result_type = typename await_result<A...>::type;
+
+  /**
+   * @brief Prepare a trampoline and store @a executor.
+   *
+   * @throws voidstar::error if the C function could not be generated.
+   */
+  explicit awaitable_callback_impl(E executor = E{})
+  requires std::default_initializable<T>
+      : m_executor{std::move(executor)}, m_closure{completion{this}} {}
+
+  /**
+   * @brief Obtain a trampoline from @a source, such as a
+   * `voidstar::closure_pool`, and store @a executor.
+   *
+   * @throws voidstar::error if the C function could not be generated.
+   */
+  template <typename S>
+  requires std::constructible_from<T, S &>
+  explicit awaitable_callback_impl(S &source, E executor = E{})
+      : m_executor{std::move(executor)}, m_closure{source, completion{this}} {}
+
+  awaitable_callback_impl(awaitable_callback_impl const &) = delete;
+  auto operator=(awaitable_callback_impl const &)
+      -> awaitable_callback_impl & = delete;
+
+  /// @brief The C function that completes the current await.
+  [[nodiscard]] auto get() const noexcept(nothrow_get) -> fn_ptr_type {
+    return m_closure.get();
+  }
+
+  /// @brief The C function that completes the current await.
+  operator fn_ptr_type() const noexcept(nothrow_get) {
+    return get();
+  }
+
+  /// @brief `true` if the callback has run since the last await.
+  [[nodiscard]] auto is_completed() const noexcept -> bool {
+    return m_state.load(std::memory_order_acquire) == completed_marker();
+  }
+
+  /// @brief Refers to the callback for the duration of one `co_await`.
+  class awaiter {
+  private:
+    awaitable_callback_impl *m_callback;
+
+  public:
+    explicit awaiter(awaitable_callback_impl &callback) noexcept
+        : m_callback{&callback} {}
+
+    [[nodiscard]] auto await_ready() const noexcept -> bool {
+      return m_callback->is_completed();
+    }
+
+    /// @brief Suspend unless the callback ran in the meantime.
+    auto await_suspend(std::coroutine_handle<> awaiting) noexcept -> bool {
+      void *expected = nullptr;
+      return m_callback->m_state.compare_exchange_strong(
+          expected, awaiting.address(), std::memory_order_acq_rel,
+          std::memory_order_acquire);
+    }
+
+    /// @brief Take the arguments of the callback and rearm it.
+    auto await_resume() -> result_type { return m_callback->take(); }
+  };
+
+  /// @brief Wait until the callback is invoked.
+  auto operator co_await() & noexcept -> awaiter { return awaiter{*this}; }
+
+private:
+  [[nodiscard]] auto completed_marker() const noexcept -> void * {
+    return const_cast<std::atomic<void *> *>(&m_state);
+  }
+
+  auto take() -> result_type {
+    auto arguments = std::move(*m_arguments);
+    m_arguments.reset();
+    m_state.store(nullptr, std::memory_order_relaxed);
+
+    if constexpr (sizeof...(A) == 1) {
+      return std::get<0>(std::move(arguments));
+    } else if constexpr (sizeof...(A) > 1) {
+      return arguments;
+    }
+  }
+
+  void complete(A... args) {
+    m_arguments.emplace(std::move(args)...);
+
+    auto *const waiting =
+        m_state.exchange(completed_marker(), std::memory_order_acq_rel);
+    if (waiting != nullptr) {
+      // May destroy *this
+      std::invoke(m_executor, std::coroutine_handle<>::from_address(waiting));
+    }
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -0,0 +1,60 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_CALL_HOOKS_H
+#define VOIDSTAR_DETAIL_CALL_HOOKS_H
+
+#include <type_traits>
+
+namespace voidstar::detail {
+
+/**
+ * @brief Per-closure code that runs around every payload invocation.
+ *
+ * `H::scope` is constructed from the closure's instance of @a H right before
+ * the payload is invoked and destroyed right after it returns, on the calling
+ * thread.
+ *
+ * Hooks may also define a default-constructible `H::entry_scope`. It lives
+ * for the whole call, from the first instruction of voidstar's entry point,
+ * before the closure object is read, until the entry point returns. Because
+ * it is constructed before the closure is read, it cannot refer to the
+ * closure's instance of @a H.
+ */
+// clang-format off
+template <typename H>
+concept call_hooks =
+  std::is_default_constructible_v<H>
+  and std::is_nothrow_constructible_v<typename H::scope, H &>
+  and std::is_nothrow_destructible_v<typename H::scope>;
+// clang-format on
+
+/// @brief Hooks that do nothing. Compile to nothing.
+struct no_call_hooks {
+  struct scope {
+    explicit scope(no_call_hooks & /* hooks */) noexcept {}
+  };
+};
+
+/// @brief The `entry_scope` of hooks that do not define one. Does nothing.
+struct no_entry_scope {};
+
+template <typename H> struct entry_scope_of {
+  using type = no_entry_scope;
+};
+
+template <typename H>
+requires requires { typename H::entry_scope; }
+struct entry_scope_of<H> {
+  static_assert(std::is_nothrow_default_constructible_v<typename H::entry_scope>
+                and
+                std::is_nothrow_destructible_v<typename H::entry_scope>);
+  using type = typename H::entry_scope;
+};
+
+/// @brief `H::entry_scope` if @a H defines one, otherwise `no_entry_scope`.
+template <typename H> using entry_scope_t = typename entry_scope_of<H>::type;
+
+} // namespace voidstar::detail
+
+#endif
@@ -47,13 +47,30 @@ struct call_signature<default_abi_var_fn<R, T...>> {
 template <typename T> struct call_signature<T *> : call_signature<T> {};
 
 /**
- * @brief Determines whether `std::apply(p_val, t_val)` is well-formed for
- * tuple-like @a T.
+ * @brief `true` if `std::apply(p, args)` with an lvalue `P p` and a
+ * `std::tuple<A...> const &args` compiles and converts to @a R, and @a P is
+ * also invocable with prvalue arguments.
+ *
+ * Checked on the pack directly; instantiating `std::apply` is comparatively
+ * expensive, and every closure type checks this several times.
  */
-template <typename P, typename T> struct can_std_apply;
-
-template <typename P, typename... A>
-struct can_std_apply<P, std::tuple<A...>> : std::is_invocable<P, A...> {};
+template <typename P, typename R, typename T> struct can_apply_as;
+
+template <typename P, typename R, typename... A>
+struct can_apply_as<P, R, std::tuple<A...>> {
+  using payload_ref = std::add_lvalue_reference_t<P>;
+
+  static constexpr bool value = [] {
+    if constexpr (std::is_invocable_v<P, A...> and
+                  std::is_invocable_v<payload_ref, A const &...>) {
+      // TODO: static_cast ins and outs
+      return std::convertible_to<
+          std::invoke_result_t<payload_ref, A const &...>, R>;
+    } else {
+      return false;
+    }
+  }();
+};
 
 /**
  * @brief Closure payload that can service trampolines with call signature @a C.
@@ -65,14 +82,7 @@ concept matches =
     typename C::return_type;
     typename C::arg_types;
   }
-
-  // Avoid hard errors if std::apply fails
-  and can_std_apply<P, typename C::arg_types>::value
-
-  and requires(P payload, typename C::arg_types const &arg_tuple) {
-    {std::apply(payload, arg_tuple)} // TODO: static_cast ins and outs
-      -> std::convertible_to<typename C::return_type>;
-  };
+  and can_apply_as<P, typename C::return_type, typename C::arg_types>::value;
 // clang-format on
 
 } // namespace voidstar::detail
@@ -0,0 +1,266 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_CLOSURE_ARENA_H
+#define VOIDSTAR_DETAIL_CLOSURE_ARENA_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/native/executable_memory.h>
+
+#include <ffi.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail {
+
+/// @brief Tuning parameters of a `closure_arena`.
+struct closure_arena_options {
+  /// @brief Size of each block that closures and payloads are carved from.
+  std::size_t data_block_size = std::size_t{64} * 1024;
+
+  /// @brief Number of trampolines in each executable block.
+  std::size_t trampolines_per_block = 1024;
+};
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+/// @brief Trampolines of closures created by a `closure_arena`.
+using arena_trampoline = ffi::placed_closure;
+#else
+/// @brief Trampolines of closures created by a `closure_arena`.
+using arena_trampoline = ffi::closure;
+#endif
+
+/// @brief The type of closures created by a `closure_arena`.
+template <typename C, matches<C> P>
+using arena_closure =
+    closure_impl<C, P, arena_trampoline, default_call_hooks<C, P>>;
+
+/**
+ * @brief Bump allocator for closures of any call signature and payload type
+ * that are all destroyed at once.
+ *
+ * Closures are constructed in large data blocks and, where executable memory
+ * can be mapped directly, their trampolines are prepared in large executable
+ * blocks. `release()` runs the destructors that are not trivial and rewinds
+ * both allocators; the blocks are kept for reuse until the arena is destroyed.
+ *
+ * Arenas are not thread-safe.
+ */
+class closure_arena {
+public:
+  /// @brief The largest supported alignment of closure types.
+  static constexpr std::size_t max_alignment = 64;
+
+private:
+  /// @brief Distance between trampolines; one cache line each.
+  static constexpr std::size_t trampoline_stride = 64;
+
+  static_assert(sizeof(ffi_closure) <= trampoline_stride);
+
+  struct aligned_delete {
+    void operator()(std::byte *block) const noexcept {
+      ::operator delete[](block, std::align_val_t{max_alignment});
+    }
+  };
+
+  struct data_block {
+    std::unique_ptr<std::byte[], aligned_delete> memory;
+    std::size_t size;
+  };
+
+  /// @brief A closure that needs its destructor called.
+  struct cleanup {
+    void (*destroy)(void *) noexcept;
+    void *object;
+    cleanup *next;
+  };
+
+  closure_arena_options m_options;
+
+  std::vector<data_block> m_data_blocks;
+  std::size_t m_data_block_index = 0;
+  std::size_t m_data_offset = 0;
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+  std::vector<native::executable_block> m_code_blocks;
+  std::size_t m_code_block_index = 0;
+  std::size_t m_code_offset = 0;
+#endif
+
+  /// @brief Most recently created closure that needs cleanup first.
+  cleanup *m_cleanups = nullptr;
+
+  std::size_t m_size = 0;
+
+public:
+  explicit closure_arena(closure_arena_options options = {})
+      : m_options{options} {}
+
+  closure_arena(closure_arena const &) = delete;
+  auto operator=(closure_arena const &) -> closure_arena & = delete;
+
+  /// @brief Arenas are not movable; closures refer to their blocks.
+  closure_arena(closure_arena &&) = delete;
+
+  /// @brief Arenas are not movable; closures refer to their blocks.
+  auto operator=(closure_arena &&) -> closure_arena & = delete;
+
+  /// @brief Destroy all closures and free all blocks.
+  ~closure_arena() { release(); }
+
+  /**
+   * @brief Construct a closure with call signature @a F and payload @a P in
+   * the arena, forwarding @a args to the payload constructor.
+   *
+   * The closure is destroyed by `release()` or the destructor of the arena.
+   *
+   * @throws Any exception thrown by the payload constructor.
+   * @throws std::bad_alloc if a data block could not be allocated.
+   * @throws voidstar::error if the C function could not be generated.
+   */
+  template <typename F, matches<call_signature<F>> P, typename... A>
+  requires std::constructible_from<P, A...>
+  auto emplace(A &&...args) -> arena_closure<call_signature<F>, P> & {
+    using closure_type = arena_closure<call_signature<F>, P>;
+    static_assert(alignof(closure_type) <= max_alignment,
+                  "Overaligned payloads are not supported by closure_arena");
+
+    constexpr bool needs_cleanup =
+        not std::is_trivially_destructible_v<closure_type>;
+
+    auto *const storage =
+        allocate_data(sizeof(closure_type), alignof(closure_type));
+    auto *const node = needs_cleanup ? static_cast<cleanup *>(allocate_data(
+                                           sizeof(cleanup), alignof(cleanup)))
+                                     : nullptr;
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+    auto location = allocate_trampoline();
+    auto *const result = ::new (storage)
+        closure_type(location, std::forward<A>(args)...);
+#else
+    auto *const result =
+        ::new (storage) closure_type(std::forward<A>(args)...);
+#endif
+
+    if constexpr (needs_cleanup) {
+      *node = cleanup{
+          .destroy = [](void *object) noexcept {
+            std::destroy_at(static_cast<closure_type *>(object));
+          },
+          .object = result,
+          .next = m_cleanups,
+      };
+      m_cleanups = node;
+    }
+
+    m_size++;
+    return *result;
+  }
+
+  /**
+   * @brief Construct a closure with call signature @a F in the arena, moving
+   * @a payload into it.
+   */
+  template <typename F, matches<call_signature<F>> P>
+  auto make(P payload) -> arena_closure<call_signature<F>, P> & {
+    return emplace<F, P>(std::move(payload));
+  }
+
+  /**
+   * @brief Destroy all closures, most recent first, and make their memory
+   * available for new closures.
+   *
+   * Destructors of closures that are trivially destructible, i.e. whose
+   * payloads are trivially destructible, are skipped.
+   */
+  void release() noexcept {
+    for (auto *node = m_cleanups; node != nullptr;) {
+      auto *const next = node->next;
+      node->destroy(node->object);
+      node = next;
+    }
+    m_cleanups = nullptr;
+    m_size = 0;
+
+    m_data_block_index = 0;
+    m_data_offset = 0;
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+    m_code_block_index = 0;
+    m_code_offset = 0;
+#endif
+  }
+
+  /// @brief The number of closures created since the last release.
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+private:
+  [[nodiscard]] auto allocate_data(std::size_t size, std::size_t alignment)
+      -> void * {
+    for (; m_data_block_index < m_data_blocks.size(); m_data_block_index++) {
+      auto const &block = m_data_blocks[m_data_block_index];
+      auto const offset =
+          (m_data_offset + alignment - 1) / alignment * alignment;
+      if (offset + size <= block.size) {
+        m_data_offset = offset + size;
+        return block.memory.get() + offset;
+      }
+      m_data_offset = 0;
+    }
+
+    auto const block_size = std::max(m_options.data_block_size, size);
+    m_data_blocks.reserve(m_data_blocks.size() + 1);
+    m_data_blocks.push_back(data_block{
+        .memory = std::unique_ptr<std::byte[], aligned_delete>{
+            static_cast<std::byte *>(::operator new[](
+                block_size, std::align_val_t{max_alignment}))},
+        .size = block_size,
+    });
+    m_data_offset = size;
+    return m_data_blocks.back().memory.get();
+  }
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+  [[nodiscard]] auto allocate_trampoline() -> ffi::closure_location {
+    auto const block_size = m_options.trampolines_per_block * trampoline_stride;
+
+    if (m_code_block_index < m_code_blocks.size() and
+        m_code_offset + trampoline_stride >
+            m_code_blocks[m_code_block_index].size()) {
+      m_code_block_index++;
+      m_code_offset = 0;
+    }
+
+    if (m_code_block_index == m_code_blocks.size()) {
+      m_code_blocks.reserve(m_code_blocks.size() + 1);
+      m_code_blocks.emplace_back(block_size);
+      m_code_offset = 0;
+    }
+
+    auto const &block = m_code_blocks[m_code_block_index];
+    auto *const writable = block.writable() + m_code_offset;
+    auto *const executable =
+        static_cast<std::byte *>(block.executable()) + m_code_offset;
+    m_code_offset += trampoline_stride;
+
+    // Reused slots hold a stale trampoline; libffi expects zeroed memory
+    std::memset(writable, 0, trampoline_stride);
+
+    return {reinterpret_cast<ffi_closure *>(writable), executable};
+  }
+#endif
+};
+
+} // namespace voidstar::detail
+
+#endif
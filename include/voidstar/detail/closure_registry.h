@@ -0,0 +1,446 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_CLOSURE_REGISTRY_H
+#define VOIDSTAR_DETAIL_CLOSURE_REGISTRY_H
+
+#include <voidstar/detail/reclaim.h>
+#include <voidstar/detail/static_closure.h>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail {
+
+/// @brief What the registry knows about a live closure.
+struct closure_info {
+  /// @brief The address of the C function.
+  void const *entry_point;
+
+  /// @brief The number of bytes from @a entry_point that belong to the
+  /// trampoline.
+  std::size_t code_size;
+
+  /// @brief The closure object.
+  void const *closure;
+
+  /// @brief The function pointer type of the closure.
+  std::type_index signature;
+
+  /// @brief The payload type of the closure.
+  std::type_index payload;
+
+  /// @brief Distinguishes closures that reuse the same address.
+  std::uint64_t id;
+};
+
+/**
+ * @brief The process-wide index of registered closures by trampoline address.
+ *
+ * The index is an immutable treap ordered by entry point and published
+ * through an atomic root pointer. Registration copies the O(log n) nodes on
+ * the path to the new entry under a mutex and publishes a new root; nodes it
+ * replaces are destroyed by the `reclaim::reclaimer` once lookups that may
+ * still read them have exited. Lookups never lock or allocate.
+ *
+ * Unregistration only clears the `live` flag of the entry, which is the one
+ * mutable part of a node, so it does not allocate either. Dead entries are
+ * dropped when an entry is registered at the same address, and the whole
+ * index is rebuilt once dead entries outnumber live ones, which amortizes to
+ * O(1) per unregistration.
+ */
+class closure_registry {
+private:
+  struct node {
+    closure_info info;
+    std::uint64_t priority;
+    node const *left = nullptr;
+    node const *right = nullptr;
+
+    /// @brief Cleared when the closure is unregistered.
+    mutable std::atomic<bool> live{true};
+
+    node(closure_info const &info, std::uint64_t priority) noexcept
+        : info{info}, priority{priority} {}
+  };
+
+  /// @brief Nodes that are unreachable from the new root of an update.
+  using garbage = std::vector<node const *>;
+
+  /// @brief Nodes created and replaced by an update that is not published
+  /// yet. Created nodes are freed if the update fails.
+  struct update {
+    std::vector<std::unique_ptr<node>> created;
+    garbage replaced;
+
+    auto create(closure_info const &info) -> node * {
+      created.push_back(
+          std::make_unique<node>(info, priority_of(info.entry_point)));
+      return created.back().get();
+    }
+
+    auto clone(node const *original) -> node * {
+      auto *const copy = create(original->info);
+      copy->left = original->left;
+      copy->right = original->right;
+      copy->live.store(original->live.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+      replaced.push_back(original);
+      return copy;
+    }
+  };
+
+  /// @brief The number of dead entries below which the index is not rebuilt.
+  static constexpr std::size_t min_rebuild_dead_count = 64;
+
+  /// @brief Serializes updates.
+  mutable std::mutex m_mutex;
+  std::atomic<node const *> m_root{nullptr};
+  std::size_t m_live_count = 0;
+  std::size_t m_dead_count = 0;
+  std::uint64_t m_next_id = 1;
+
+  closure_registry() {
+    // Started here so that publishing never has to start it
+    (void)reclaim::reclaimer::instance();
+  }
+
+public:
+  /**
+   * @brief The process-wide registry.
+   *
+   * It is never destroyed so that closures with static storage duration may
+   * unregister during static destruction.
+   */
+  [[nodiscard]] static auto instance() -> closure_registry & {
+    static auto *const singleton = new closure_registry{};
+    return *singleton;
+  }
+
+  closure_registry(closure_registry const &) = delete;
+  auto operator=(closure_registry const &) -> closure_registry & = delete;
+
+  /**
+   * @brief Register a closure whose trampoline starts at @a entry_point.
+   *
+   * O(log n) expected time and allocations.
+   *
+   * @return The id of the registration.
+   * @throws std::bad_alloc; the registry is unchanged in that case.
+   */
+  auto add(void const *entry_point, std::size_t code_size,
+           void const *closure, std::type_index signature,
+           std::type_index payload) -> std::uint64_t {
+    std::lock_guard const lock{m_mutex};
+
+    update pending;
+    auto *const fresh = pending.create(closure_info{
+        .entry_point = entry_point,
+        .code_size = code_size,
+        .closure = closure,
+        .signature = signature,
+        .payload = payload,
+        .id = m_next_id,
+    });
+
+    node const *displaced = nullptr;
+    auto const *const root =
+        insert(m_root.load(std::memory_order_relaxed), fresh, pending,
+               displaced);
+
+    // The displaced node is retired by publish()
+    auto const displaced_live =
+        displaced != nullptr and
+        displaced->live.load(std::memory_order_relaxed);
+    auto const displaced_dead = displaced != nullptr and not displaced_live;
+
+    publish(root, pending);
+
+    m_live_count += displaced_live ? 0 : 1;
+    m_dead_count -= displaced_dead ? 1 : 0;
+    return m_next_id++;
+  }
+
+  /**
+   * @brief Unregister the closure registered at @a entry_point as @a id.
+   *
+   * O(log n) expected time; does not allocate unless the index is rebuilt.
+   */
+  void remove(void const *entry_point, std::uint64_t id) noexcept {
+    std::lock_guard const lock{m_mutex};
+
+    auto const key = address_of(entry_point);
+    auto const *n = m_root.load(std::memory_order_relaxed);
+    while (n != nullptr and address_of(n->info.entry_point) != key) {
+      n = key < address_of(n->info.entry_point) ? n->left : n->right;
+    }
+    if (n == nullptr or n->info.id != id or
+        not n->live.load(std::memory_order_relaxed)) {
+      return;
+    }
+
+    n->live.store(false, std::memory_order_release);
+    m_live_count--;
+    m_dead_count++;
+
+    if (m_dead_count >= min_rebuild_dead_count and
+        m_dead_count > m_live_count) {
+      try {
+        rebuild();
+      } catch (...) {
+        // Keep the dead entries until the next attempt
+      }
+    }
+  }
+
+  /**
+   * @brief Find the live closure whose trampoline contains @a address.
+   *
+   * O(log n) expected time. Never locks or allocates.
+   */
+  [[nodiscard]] auto find(void const *address) const noexcept
+      -> std::optional<closure_info> {
+    auto &domain = reclaim::domain::global();
+    auto const token = domain.enter();
+
+    // The entry with the greatest entry point at or below the address
+    auto const key = address_of(address);
+    node const *candidate = nullptr;
+    auto const *n = m_root.load(std::memory_order_acquire);
+    while (n != nullptr) {
+      if (address_of(n->info.entry_point) <= key) {
+        candidate = n;
+        n = n->right;
+      } else {
+        n = n->left;
+      }
+    }
+
+    std::optional<closure_info> result;
+    if (candidate != nullptr and
+        candidate->live.load(std::memory_order_acquire) and
+        key - address_of(candidate->info.entry_point) <
+            candidate->info.code_size) {
+      result = candidate->info;
+    }
+
+    domain.exit(token);
+    return result;
+  }
+
+  /// @brief The number of registered closures.
+  [[nodiscard]] auto size() const -> std::size_t {
+    std::lock_guard const lock{m_mutex};
+    return m_live_count;
+  }
+
+private:
+  [[nodiscard]] static auto address_of(void const *pointer) noexcept
+      -> std::uintptr_t {
+    return reinterpret_cast<std::uintptr_t>(pointer);
+  }
+
+  /// @brief A pseudo-random treap priority derived from @a entry_point.
+  [[nodiscard]] static auto priority_of(void const *entry_point) noexcept
+      -> std::uint64_t {
+    // splitmix64 finalizer
+    auto x = static_cast<std::uint64_t>(address_of(entry_point));
+    x = (x ^ (x >> 30U)) * 0xBF58476D1CE4E5B9U;
+    x = (x ^ (x >> 27U)) * 0x94D049BB133111EBU;
+    return x ^ (x >> 31U);
+  }
+
+  /**
+   * @brief Insert @a fresh into the treap at @a root, copying the nodes on
+   * the way.
+   *
+   * @param displaced Set to the entry at the same address, if any, which
+   * @a fresh replaces.
+   * @return The new root.
+   */
+  static auto insert(node const *root, node *fresh, update &pending,
+                     node const *&displaced) -> node const * {
+    if (root == nullptr) {
+      return fresh;
+    }
+
+    auto const key = address_of(fresh->info.entry_point);
+    auto const root_key = address_of(root->info.entry_point);
+
+    if (key == root_key) {
+      fresh->left = root->left;
+      fresh->right = root->right;
+      pending.replaced.push_back(root);
+      displaced = root;
+      return fresh;
+    }
+
+    if (fresh->priority > root->priority) {
+      auto const [less, greater] = split(root, key, pending, displaced);
+      fresh->left = less;
+      fresh->right = greater;
+      return fresh;
+    }
+
+    auto *const copy = pending.clone(root);
+    if (key < root_key) {
+      copy->left = insert(root->left, fresh, pending, displaced);
+    } else {
+      copy->right = insert(root->right, fresh, pending, displaced);
+    }
+    return copy;
+  }
+
+  /**
+   * @brief Split the treap at @a root into entries below and above @a key,
+   * copying the nodes on the way. An entry at @a key is dropped.
+   */
+  static auto split(node const *root, std::uintptr_t key, update &pending,
+                    node const *&displaced)
+      -> std::pair<node const *, node const *> {
+    if (root == nullptr) {
+      return {nullptr, nullptr};
+    }
+
+    auto const root_key = address_of(root->info.entry_point);
+    if (root_key == key) {
+      pending.replaced.push_back(root);
+      displaced = root;
+      return {root->left, root->right};
+    }
+
+    auto *const copy = pending.clone(root);
+    if (root_key < key) {
+      auto const [less, greater] =
+          split(root->right, key, pending, displaced);
+      copy->right = less;
+      return {copy, greater};
+    }
+
+    auto const [less, greater] = split(root->left, key, pending, displaced);
+    copy->left = greater;
+    return {less, copy};
+  }
+
+  /// @brief Replace the index with one that only holds live entries.
+  void rebuild() {
+    update pending;
+
+    std::vector<node const *> in_order;
+    in_order.reserve(m_live_count + m_dead_count);
+    collect(m_root.load(std::memory_order_relaxed), in_order);
+    pending.replaced.reserve(in_order.size());
+
+    // Cartesian tree construction: a max-heap on priority in O(n)
+    std::vector<node *> spine;
+    for (auto const *original : in_order) {
+      pending.replaced.push_back(original);
+      if (not original->live.load(std::memory_order_relaxed)) {
+        continue;
+      }
+
+      auto *const current = pending.create(original->info);
+      node *last_popped = nullptr;
+      while (not spine.empty() and spine.back()->priority < current->priority) {
+        last_popped = spine.back();
+        spine.pop_back();
+      }
+      current->left = last_popped;
+      if (not spine.empty()) {
+        spine.back()->right = current;
+      }
+      spine.push_back(current);
+    }
+
+    publish(spine.empty() ? nullptr : spine.front(), pending);
+    m_dead_count = 0;
+  }
+
+  static void collect(node const *root, std::vector<node const *> &out) {
+    if (root != nullptr) {
+      collect(root->left, out);
+      out.push_back(root);
+      collect(root->right, out);
+    }
+  }
+
+  /**
+   * @brief Make @a root the index and retire the nodes @a pending replaced.
+   *
+   * @throws std::bad_alloc before anything is published.
+   */
+  void publish(node const *root, update &pending) {
+    auto retired = pending.replaced.empty()
+                       ? nullptr
+                       : std::make_unique<garbage>(std::move(pending.replaced));
+
+    for (auto &created : pending.created) {
+      (void)created.release();
+    }
+    m_root.store(root, std::memory_order_release);
+
+    if (retired != nullptr) {
+      reclaim::reclaimer::instance().retire(
+          retired.release(), [](void *nodes) noexcept {
+            auto *const batch = static_cast<garbage *>(nodes);
+            for (auto const *n : *batch) {
+              delete n;
+            }
+            delete batch;
+          });
+    }
+  }
+};
+
+/**
+ * @brief A closure @a C that is listed in the `closure_registry` for as long
+ * as it exists.
+ */
+template <typename C> class registered : public C {
+private:
+  static_assert(not std::same_as<typename C::trampoline_type,
+                                 static_trampoline>,
+                "Closures without a trampoline of their own cannot be "
+                "registered");
+
+  std::uint64_t m_id;
+
+public:
+  /**
+   * @brief Construct the closure from @a args and register it.
+   *
+   * @throws Any exception thrown by the closure constructor.
+   * @throws std::bad_alloc if the closure could not be registered.
+   */
+  template <typename... A>
+  requires std::constructible_from<C, A...>
+  explicit registered(A &&...args)
+      : C(std::forward<A>(args)...),
+        m_id{closure_registry::instance().add(
+            reinterpret_cast<void const *>(this->get()), this->code_size(),
+            static_cast<C const *>(this),
+            typeid(typename C::call_signature::fn_ptr_type),
+            typeid(typename C::payload_type))} {}
+
+  registered(registered const &) = delete;
+  auto operator=(registered const &) -> registered & = delete;
+
+  /// @brief Unregister the closure before it is destroyed.
+  ~registered() {
+    closure_registry::instance().remove(
+        reinterpret_cast<void const *>(this->get()), m_id);
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
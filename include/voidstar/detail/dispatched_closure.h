@@ -0,0 +1,190 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_DISPATCHED_CLOSURE_H
+#define VOIDSTAR_DETAIL_DISPATCHED_CLOSURE_H
+
+#include <voidstar/detail/call_signature.h>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <semaphore>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar::detail {
+
+/// @brief Something that runs submitted nullary callables of type @a F,
+/// usually on other threads.
+template <typename E, typename F>
+concept executor_of = std::invocable<F &> and requires(E &executor, F fun) {
+  executor.submit(std::move(fun));
+};
+
+/// @brief An executor that can tell whether the calling thread is one of its
+/// own.
+template <typename E>
+concept thread_aware_executor = requires(E const &executor) {
+  { executor.running_in_this_thread() } -> std::convertible_to<bool>;
+};
+
+/**
+ * @brief Counts dispatched calls that have not finished, so that their
+ * dispatcher can wait for them before it is destroyed.
+ *
+ * Finished calls never touch the counter again, and only wake waiters through
+ * process-wide atomics, so the counter may be destroyed as soon as it reads
+ * zero.
+ */
+class pending_calls {
+private:
+  static inline constinit std::atomic<std::uint32_t> s_waiters{0};
+  static inline constinit std::atomic<std::uint32_t> s_epoch{0};
+
+  std::atomic<std::size_t> m_count{0};
+
+public:
+  constexpr pending_calls() = default;
+
+  pending_calls(pending_calls const &) = delete;
+  auto operator=(pending_calls const &) -> pending_calls & = delete;
+
+  void begin() noexcept { m_count.fetch_add(1, std::memory_order_relaxed); }
+
+  void end() noexcept {
+    if (m_count.fetch_sub(1, std::memory_order_seq_cst) == 1 and
+        s_waiters.load(std::memory_order_seq_cst) != 0) {
+      s_epoch.fetch_add(1, std::memory_order_seq_cst);
+      s_epoch.notify_all();
+    }
+  }
+
+  /// @brief The number of calls that have not finished.
+  [[nodiscard]] auto count() const noexcept -> std::size_t {
+    return m_count.load(std::memory_order_acquire);
+  }
+
+  /// @brief Block until all calls have finished.
+  void wait() const noexcept {
+    if (count() == 0) {
+      return;
+    }
+
+    s_waiters.fetch_add(1, std::memory_order_seq_cst);
+    while (true) {
+      auto const epoch = s_epoch.load(std::memory_order_seq_cst);
+      if (m_count.load(std::memory_order_seq_cst) == 0) {
+        break;
+      }
+      s_epoch.wait(epoch, std::memory_order_seq_cst);
+    }
+    s_waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief A payload that invokes payload @a P on executor @a E instead of the
+ * calling thread.
+ *
+ * Calls without a result are submitted and return immediately. Calls with a
+ * result block the caller until the executor has run them, unless the caller
+ * is a thread of the executor, in which case they run inline.
+ *
+ * Calls come from C code, which exceptions must not unwind through. An
+ * exception thrown by the payload, or by the executor while submitting a call,
+ * terminates the program.
+ *
+ * The destructor waits for submitted calls to finish.
+ *
+ * @tparam C Call signature of the closure.
+ * @tparam P The payload to invoke.
+ * @tparam E The executor.
+ */
+template <typename C, typename P, typename E,
+          typename arg_types = typename C::arg_types>
+class dispatcher;
+
+template <typename C, typename P, typename E, typename... A>
+class dispatcher<C, P, E, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  E *m_executor;
+  P m_payload;
+  pending_calls m_pending;
+
+public:
+  /**
+   * @brief Construct the payload from @a args and refer to @a executor, which
+   * must outlive this object.
+   */
+  template <typename... S>
+  requires std::constructible_from<P, S...>
+  explicit dispatcher(E &executor, S &&...args)
+      : m_executor{&executor}, m_payload(std::forward<S>(args)...) {}
+
+  dispatcher(dispatcher const &) = delete;
+  auto operator=(dispatcher const &) -> dispatcher & = delete;
+
+  /// @brief Wait for submitted calls to finish.
+  ~dispatcher() { m_pending.wait(); }
+
+  auto operator()(A... args) noexcept -> return_type {
+    if constexpr (std::is_void_v<return_type>) {
+      dispatch(std::move(args)...);
+    } else {
+      return rendezvous(std::move(args)...);
+    }
+  }
+
+  /// @brief The executor calls are submitted to.
+  [[nodiscard]] auto executor() const noexcept -> E & { return *m_executor; }
+
+  /// @brief The number of submitted calls that have not finished.
+  [[nodiscard]] auto pending() const noexcept -> std::size_t {
+    return m_pending.count();
+  }
+
+  /// @brief Block until submitted calls have finished.
+  void wait_idle() const noexcept { m_pending.wait(); }
+
+private:
+  // Both are noexcept: an exception from submit() or the payload terminates
+  // instead of unwinding into the C caller
+
+  void dispatch(A... args) noexcept {
+    m_pending.begin();
+    m_executor->submit([this, ... args = std::move(args)]() mutable noexcept {
+      std::invoke(m_payload, std::move(args)...);
+      m_pending.end();
+    });
+  }
+
+  auto rendezvous(A... args) noexcept -> return_type {
+    if constexpr (thread_aware_executor<E>) {
+      if (m_executor->running_in_this_thread()) {
+        return std::invoke(m_payload, std::move(args)...);
+      }
+    }
+
+    std::optional<return_type> result;
+    std::binary_semaphore done{0};
+
+    m_executor->submit([&, ... args = std::move(args)]() mutable noexcept {
+      result.emplace(std::invoke(m_payload, std::move(args)...));
+      done.release();
+    });
+    done.acquire();
+
+    return std::move(*result);
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -17,20 +17,33 @@
 
 namespace voidstar::detail::ffi {
 
+/**
+ * @brief Prepare @a cif for a function with the default ABI.
+ *
+ * Shared by all call signatures, so that error handling is not compiled for
+ * each of them.
+ *
+ * @throws ffi::error if libffi rejects the types.
+ */
+inline void prepare_cif(ffi_cif *cif, ffi_type *return_type,
+                        std::span<ffi_type *> arg_types) {
+  ffi::call(ffi_prep_cif, "ffi_prep_cif") //
+      (/* cif = */ cif,
+       /* abi = */ FFI_DEFAULT_ABI,
+       /* nargs = */ static_cast<unsigned>(arg_types.size()),
+       /* rtype = */ return_type,
+       /* atypes = */ arg_types.data());
+}
+
 // Implementation of cif is greatly shortened if argument types are a pack
 template <typename call_signature, typename arg_types> class cif_impl;
 
 template <typename call_signature, typename... A>
 class cif_impl<call_signature, std::tuple<A...>> {
 private:
-  type_description<typename call_signature::return_type> m_return_type;
-  std::tuple<type_description<A>...> m_arg_types;
-
   using arg_type_list = std::array<ffi_type *, call_signature::arg_count>;
 
-  arg_type_list m_arg_type_list = std::apply(
-      [&](auto &&...arg_types) { return arg_type_list{arg_types.raw()...}; },
-      m_arg_types);
+  arg_type_list m_arg_type_list{interned_type<A>()...};
 
   ffi_cif m_raw;
 
@@ -38,12 +51,9 @@ private:
 
 public:
   cif_impl() {
-    ffi::call(ffi_prep_cif, "ffi_prep_cif") //
-        (/* cif = */ &m_raw,
-         /* abi = */ FFI_DEFAULT_ABI,
-         /* nargs = */ m_arg_type_list.size(),
-         /* rtype = */ m_return_type.raw(),
-         /* atypes = */ m_arg_type_list.data());
+    prepare_cif(&m_raw,
+                interned_type<typename call_signature::return_type>(),
+                m_arg_type_list);
   }
 
   /// @brief Pointer to underlying `ffi_cif` struct.
@@ -57,6 +67,19 @@ public:
 template <typename call_signature>
 using cif = cif_impl<call_signature, typename call_signature::arg_types>;
 
+/**
+ * @brief Process-wide prepared `ffi_cif` for @a call_signature.
+ *
+ * The cif is prepared on first use in a thread-safe manner and is shared by all
+ * closures with the same call signature. If preparation fails, the exception
+ * propagates to the caller and the next call retries.
+ */
+template <typename call_signature>
+[[nodiscard]] auto shared_cif() -> ffi_cif * {
+  static cif<call_signature> instance;
+  return instance.raw();
+}
+
 } // namespace voidstar::detail::ffi
 
 #endif
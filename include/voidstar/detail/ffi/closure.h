@@ -4,78 +4,226 @@
 #ifndef VOIDSTAR_DETAIL_FFI_CLOSURE_H
 #define VOIDSTAR_DETAIL_FFI_CLOSURE_H
 
+#include <voidstar/detail/call_hooks.h>
 #include <voidstar/detail/ffi/cif.h>
+#include <voidstar/detail/ffi/closure_cache.h>
 #include <voidstar/detail/misc.h>
 
 #include <ffi.h>
 
 #include <concepts>
+#include <cstddef>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace voidstar::detail::ffi {
 
-/// @brief A RAII wrapper for a `ffi_closure`.
+/// @brief Signature of the function libffi calls from within a trampoline.
+using entrypoint_type = void(ffi_cif *, void *, void **, void *);
+
+/**
+ * @brief A RAII wrapper for a `ffi_closure`.
+ *
+ * Closures are allocated from and returned to the calling thread's
+ * `closure_cache`.
+ */
 class closure {
 private:
-  /// @brief Type-erased function pointer to the trampoline.
-  void *m_executable_ptr;
-
   struct deleter {
+    /// @brief Type-erased function pointer to the trampoline.
+    void *executable_ptr;
+
     void operator()(ffi_closure *writable) const noexcept {
-      ffi_closure_free(writable);
+      closure_cache::release({writable, executable_ptr});
     }
   };
 
   std::unique_ptr<ffi_closure, deleter> m_raw;
 
+  explicit closure(closure_allocation allocation) noexcept
+      : m_raw{allocation.writable, deleter{allocation.executable}} {}
+
 public:
-  closure()
-      : m_executable_ptr{nullptr},
-        m_raw{
-            static_cast<ffi_closure *>(
-                ffi_closure_alloc(sizeof(ffi_closure), &m_executable_ptr)),
-        } {
-    if (m_raw == nullptr or m_executable_ptr == nullptr) {
-      throw ffi::error{"Could not allocate an FFI closure"};
-    }
-  }
+  /**
+   * @brief Allocate a closure.
+   *
+   * @throws ffi::error if libffi could not allocate a closure.
+   */
+  closure() : closure{closure_cache::acquire()} {}
 
   /// @brief Get type-erased function pointer to the trampoline.
   [[nodiscard]] auto executable_ptr() const noexcept -> void * {
-    return m_executable_ptr;
+    return m_raw.get_deleter().executable_ptr;
   };
 
+  /// @brief The number of bytes of trampoline code at `executable_ptr()`.
+  [[nodiscard]] static constexpr auto code_size() noexcept -> std::size_t {
+    return FFI_TRAMPOLINE_SIZE;
+  }
+
   /// @brief Pointer to underlying `ffi_closure` struct.
   [[nodiscard]] auto raw() const noexcept -> ffi_closure * {
     return m_raw.get();
   };
+
+  /// @brief Free the closure with `ffi_closure_free` instead of returning it
+  /// to the `closure_cache`. The object is left empty.
+  void free_uncached() && noexcept {
+    auto const executable = executable_ptr();
+    if (auto *const writable = m_raw.release(); writable != nullptr) {
+      closure_cache::free({writable, executable});
+    }
+  }
+
+  /**
+   * @brief Prepare the trampoline to invoke @a fun with @a user_data.
+   *
+   * @throws ffi::error if libffi rejects the closure.
+   */
+  void bind(ffi_cif *cif, entrypoint_type *fun, void *user_data) {
+    ffi::call(ffi_prep_closure_loc, "ffi_prep_closure_loc") //
+        (/* closure = */ m_raw.get(),
+         /* cif = */ cif,
+         /* fun = */ fun,
+         /* user_data = */ user_data,
+         /* codeloc = */ executable_ptr());
+  }
+};
+
+/// @brief Memory for a `placed_closure`.
+struct closure_location {
+  /// @brief Zero-filled writable memory for the `ffi_closure`.
+  ffi_closure *writable;
+
+  /// @brief The address at which @a writable is executable.
+  void *executable;
+};
+
+/**
+ * @brief A `ffi_closure` prepared in memory owned by someone else.
+ *
+ * The memory is not freed on destruction.
+ */
+class placed_closure {
+private:
+  closure_location m_location;
+
+public:
+  explicit placed_closure(closure_location &location) noexcept
+      : m_location{location} {}
+
+  /// @brief Get type-erased function pointer to the trampoline.
+  [[nodiscard]] auto executable_ptr() const noexcept -> void * {
+    return m_location.executable;
+  };
+
+  /// @brief The number of bytes of trampoline code at `executable_ptr()`.
+  [[nodiscard]] static constexpr auto code_size() noexcept -> std::size_t {
+    return FFI_TRAMPOLINE_SIZE;
+  }
+
+  /**
+   * @brief Prepare the trampoline to invoke @a fun with @a user_data.
+   *
+   * @throws ffi::error if libffi rejects the closure.
+   */
+  void bind(ffi_cif *cif, entrypoint_type *fun, void *user_data) {
+    ffi::call(ffi_prep_closure_loc, "ffi_prep_closure_loc") //
+        (/* closure = */ m_location.writable,
+         /* cif = */ cif,
+         /* fun = */ fun,
+         /* user_data = */ user_data,
+         /* codeloc = */ m_location.executable);
+  }
+};
+
+/**
+ * @brief A trampoline that redirects calls to libffi-style
+ * `fun(cif, ret, args, user_data)` once bound.
+ */
+template <typename T>
+concept binds_entrypoint = requires(T &trampoline, ffi_cif *cif,
+                                    entrypoint_type *fun, void *user_data) {
+  {trampoline.bind(cif, fun, user_data)};
+};
+
+/**
+ * @brief A trampoline that redirects calls to `thunk(args..., user_data)` once
+ * bound, where `thunk` has the exact call signature of the closure with an
+ * extra trailing `void *` parameter.
+ */
+template <typename T>
+concept binds_thunk = requires(T &trampoline, void *thunk, void *user_data) {
+  {trampoline.bind_thunk(thunk, user_data)};
 };
 
+/**
+ * @brief A trampoline that is a statically compiled function of the exact
+ * call signature of the closure and receives no context. Only suitable for
+ * stateless payloads and closures without call hooks.
+ */
+template <typename T>
+concept binds_static = requires(T &trampoline, void *function) {
+  {trampoline.bind_static(function)};
+};
+
+/**
+ * @brief A source of trampolines for `prepared_closure`.
+ *
+ * A trampoline owns the executable code of a single closure. `code_size()`
+ * is the number of bytes of that code starting at `executable_ptr()`, or 1 if
+ * only the entry point itself is known to belong to the closure.
+ */
+// clang-format off
+template <typename T>
+concept trampoline =
+  std::is_nothrow_destructible_v<T>
+  and (binds_entrypoint<T> or binds_thunk<T> or binds_static<T>)
+  and requires(T const &trampoline) {
+    { trampoline.executable_ptr() } -> std::same_as<void *>;
+    { trampoline.code_size() } noexcept -> std::same_as<std::size_t>;
+  };
+// clang-format on
+
 /**
  * @brief A RAII wrapper for a prepared `ffi_closure` and referenced objects.
  *
  * @tparam call_signature A detail::call_signature describing the call signature
  * of the trampoline.
  * @tparam derived A CRTP parameter; must have an `m_payload` that
- * `detail::matches` @a call_signature.
+ * `detail::matches` @a call_signature, and an `m_hooks` of type
+ * `derived::hooks_type` that satisfies `detail::call_hooks`.
+ * @tparam T The trampoline implementation.
  */
-template <typename call_signature, typename derived> class prepared_closure {
+template <typename call_signature, typename derived,
+          trampoline T = ffi::closure>
+class prepared_closure {
 private:
-  cif<call_signature> m_cif;
-  closure m_closure;
+  T m_closure;
 
   [[no_unique_address]] pin m_pin; // `this` is baked into the closure
 
 public:
-  prepared_closure() {
-    ffi::call(ffi_prep_closure_loc, "ffi_prep_closure_loc") //
-        (/* closure = */ m_closure.raw(),
-         /* cif = */ m_cif.raw(),
-         /* fun = */ entrypoint,
-         /* user_data = */ this,
-         /* codeloc = */ m_closure.executable_ptr());
+  /**
+   * @brief Construct a trampoline from @a trampoline_args and bind it to this
+   * object.
+   */
+  template <typename... A>
+  requires std::constructible_from<T, A...>
+  explicit prepared_closure(A &&...trampoline_args)
+      : m_closure{std::forward<A>(trampoline_args)...} {
+    if constexpr (binds_static<T>) {
+      m_closure.bind_static(
+          reinterpret_cast<void *>(&unpacked<arg_types>::stateless));
+    } else if constexpr (binds_thunk<T>) {
+      m_closure.bind_thunk(
+          reinterpret_cast<void *>(&unpacked<arg_types>::thunk), this);
+    } else {
+      m_closure.bind(shared_cif<call_signature>(), &entrypoint, this);
+    }
   }
 
 private:
@@ -95,18 +243,63 @@ private:
    * coerced into call signature's return type.
    */
   auto call(void **args) -> return_type {
-    return with_indices_zero_thru<arg_count>([&](auto... i) {
-      return std::invoke(
-          static_cast<derived *>(this)->m_payload,
-          *static_cast<std::tuple_element_t<i, arg_types> *>(args[i])...);
-    });
+    auto *const self = static_cast<derived *>(this);
+    [[maybe_unused]] typename derived::hooks_type::scope const scope{
+        self->m_hooks};
+
+    return unpacked<arg_types>::call(*self, args,
+                                     std::make_index_sequence<arg_count>{});
   }
 
+  /**
+   * @brief Code that needs the argument types as a pack.
+   *
+   * Specializing once on the pack keeps the per-signature instantiation work
+   * flat: no recursive or per-index helpers are involved.
+   */
+  template <typename tuple> struct unpacked;
+
+  template <typename... A> struct unpacked<std::tuple<A...>> {
+    template <std::size_t... I>
+    static auto call(derived &self, void **args, std::index_sequence<I...>)
+        -> return_type {
+      return std::invoke(self.m_payload, *static_cast<A *>(args[I])...);
+    }
+
+    /**
+     * @brief Called by trampolines that support `binds_thunk`.
+     */
+    static auto thunk(A... args, void *user_data) -> return_type {
+      [[maybe_unused]] entry_scope_t<typename derived::hooks_type> const
+          entered{};
+
+      auto *const self =
+          static_cast<derived *>(static_cast<prepared_closure *>(user_data));
+      [[maybe_unused]] typename derived::hooks_type::scope const scope{
+          self->m_hooks};
+
+      return static_cast<return_type>(std::invoke(self->m_payload, args...));
+    }
+
+    /**
+     * @brief Called instead of a trampoline by trampolines that support
+     * `binds_static`. The payload is stateless, so a fresh instance stands in
+     * for `derived::m_payload`.
+     */
+    static auto stateless(A... args) -> return_type {
+      typename derived::payload_type payload{};
+      return static_cast<return_type>(std::invoke(payload, args...));
+    }
+  };
+
   /**
    * @brief Called by libffi from within the trampoline.
    */
   static void entrypoint(ffi_cif *cif, void *ret, void **args,
                          void *user_data) {
+    // Before anything reads the closure
+    [[maybe_unused]] entry_scope_t<typename derived::hooks_type> const
+        entered{};
 
     if (cif == nullptr or user_data == nullptr) {
       return;
@@ -150,10 +343,27 @@ public:
   /// @brief Pointer-to-function type of this closure.
   using fn_ptr_type = typename call_signature::fn_ptr_type;
 
-  /// @brief Obtain a function pointer to the trampoline.
-  [[nodiscard]] auto get() const noexcept -> fn_ptr_type {
+  /// @brief `true` unless the trampoline is prepared on first access.
+  static constexpr bool nothrow_get =
+      noexcept(std::declval<T const &>().executable_ptr());
+
+  /**
+   * @brief Obtain a function pointer to the trampoline.
+   *
+   * @throws voidstar::error if the trampoline is prepared lazily and could not
+   * be prepared.
+   */
+  [[nodiscard]] auto get() const noexcept(nothrow_get) -> fn_ptr_type {
     return reinterpret_cast<fn_ptr_type>(m_closure.executable_ptr());
   }
+
+  /**
+   * @brief The number of bytes of code at `get()` that belong to this
+   * closure.
+   */
+  [[nodiscard]] auto code_size() const noexcept -> std::size_t {
+    return m_closure.code_size();
+  }
 };
 
 } // namespace voidstar::detail::ffi
@@ -0,0 +1,261 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_FFI_CLOSURE_CACHE_H
+#define VOIDSTAR_DETAIL_FFI_CLOSURE_CACHE_H
+
+#include <voidstar/detail/ffi/error.h>
+
+#include <ffi.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace voidstar::detail::ffi {
+
+/// @brief An `ffi_closure` allocated with `ffi_closure_alloc`.
+struct closure_allocation {
+  ffi_closure *writable = nullptr;
+  void *executable = nullptr;
+};
+
+/**
+ * @brief Per-thread caches of allocated `ffi_closure`s in front of a shared
+ * depot, to keep threads off libffi's global allocator lock.
+ *
+ * Threads move closures between their cache and the depot in batches, so the
+ * depot lock is taken at most once per `batch_size` allocations or frees.
+ * Closures are returned to libffi when the depot overflows and by `trim()`.
+ */
+class closure_cache {
+public:
+  /// @brief The number of closures moved between a thread and the depot.
+  static constexpr std::size_t batch_size = 32;
+
+  /// @brief The most closures a thread keeps.
+  static constexpr std::size_t thread_capacity = 2 * batch_size;
+
+  /// @brief The most closures the depot keeps.
+  static constexpr std::size_t depot_capacity = 64 * batch_size;
+
+private:
+  struct batch {
+    std::array<closure_allocation, batch_size> entries;
+    std::size_t count = 0;
+  };
+
+  class depot {
+  private:
+    mutable std::mutex m_mutex;
+    std::vector<closure_allocation> m_free;
+
+  public:
+    /// @brief Move up to `batch_size` closures into @a into.
+    void take(batch &into) noexcept {
+      std::lock_guard const lock{m_mutex};
+      while (into.count < batch_size and not m_free.empty()) {
+        into.entries[into.count++] = m_free.back();
+        m_free.pop_back();
+      }
+    }
+
+    /// @brief Keep @a count closures from @a from, freeing the overflow.
+    void put(closure_allocation const *from, std::size_t count) noexcept {
+      std::size_t kept = 0;
+      {
+        std::lock_guard const lock{m_mutex};
+        try {
+          m_free.reserve(depot_capacity);
+          while (kept < count and m_free.size() < depot_capacity) {
+            m_free.push_back(from[kept++]);
+          }
+        } catch (...) {
+          // Free the rest
+        }
+      }
+
+      for (; kept < count; kept++) {
+        free(from[kept]);
+      }
+    }
+
+    /// @brief Free all closures in the depot.
+    void clear() noexcept {
+      std::vector<closure_allocation> taken;
+      {
+        std::lock_guard const lock{m_mutex};
+        taken.swap(m_free);
+      }
+
+      for (auto const &allocation : taken) {
+        free(allocation);
+      }
+    }
+
+    /// @brief The number of closures in the depot.
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+      std::lock_guard const lock{m_mutex};
+      return m_free.size();
+    }
+  };
+
+  struct thread_cache {
+    std::array<closure_allocation, thread_capacity> entries{};
+    std::size_t count = 0;
+
+    thread_cache() = default;
+    thread_cache(thread_cache const &) = delete;
+    auto operator=(thread_cache const &) -> thread_cache & = delete;
+
+    ~thread_cache() {
+      shared_depot().put(entries.data(), count);
+      this_thread_state() = state::destroyed;
+    }
+  };
+
+  enum class state { uninitialized, alive, destroyed };
+
+public:
+  /**
+   * @brief Take an allocated closure from this thread's cache.
+   *
+   * @throws ffi::error if the cache is empty and libffi could not allocate a
+   * closure.
+   */
+  [[nodiscard]] static auto acquire() -> closure_allocation {
+    auto *const cache = this_thread_cache();
+    if (cache == nullptr) {
+      return allocate();
+    }
+
+    if (cache->count == 0) {
+      refill(*cache);
+    }
+    return cache->entries[--cache->count];
+  }
+
+  /// @brief Return @a released to this thread's cache.
+  static void release(closure_allocation released) noexcept {
+    auto *const cache = this_thread_cache();
+    if (cache == nullptr) {
+      shared_depot().put(&released, 1);
+      return;
+    }
+
+    if (cache->count == thread_capacity) {
+      cache->count -= batch_size;
+      shared_depot().put(cache->entries.data() + cache->count, batch_size);
+    }
+    cache->entries[cache->count++] = released;
+  }
+
+  /// @brief Return @a released to libffi, bypassing the caches.
+  static void free(closure_allocation released) noexcept {
+    ffi_closure_free(released.writable);
+    s_allocated.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Return the closures cached by the calling thread and by the depot
+   * to libffi.
+   *
+   * Closures cached by other threads are kept.
+   */
+  static void trim() noexcept {
+    if (auto *const cache = this_thread_cache(); cache != nullptr) {
+      for (std::size_t i = 0; i < cache->count; i++) {
+        free(cache->entries[i]);
+      }
+      cache->count = 0;
+    }
+    shared_depot().clear();
+  }
+
+  /// @brief The number of closures in the depot.
+  [[nodiscard]] static auto depot_size() noexcept -> std::size_t {
+    return shared_depot().size();
+  }
+
+  /// @brief The number of closures allocated from libffi and not yet freed,
+  /// whether in use or cached.
+  [[nodiscard]] static auto allocated() noexcept -> std::size_t {
+    return s_allocated.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constinit inline std::atomic<std::size_t> s_allocated{0};
+
+  [[nodiscard]] static auto allocate() -> closure_allocation {
+    closure_allocation result;
+    result.writable = static_cast<ffi_closure *>(
+        ffi_closure_alloc(sizeof(ffi_closure), &result.executable));
+    if (result.writable == nullptr or result.executable == nullptr) {
+      if (result.writable != nullptr) {
+        ffi_closure_free(result.writable);
+      }
+      throw ffi::error{"Could not allocate an FFI closure"};
+    }
+    s_allocated.fetch_add(1, std::memory_order_relaxed);
+    return result;
+  }
+
+  static void refill(thread_cache &cache) {
+    batch taken;
+    shared_depot().take(taken);
+
+    if (taken.count == 0) {
+      // Allocate a whole batch now so the next allocations stay local
+      cache.entries[cache.count++] = allocate();
+      while (cache.count < batch_size) {
+        closure_allocation extra;
+        extra.writable = static_cast<ffi_closure *>(
+            ffi_closure_alloc(sizeof(ffi_closure), &extra.executable));
+        if (extra.writable == nullptr) {
+          break;
+        }
+        s_allocated.fetch_add(1, std::memory_order_relaxed);
+        cache.entries[cache.count++] = extra;
+      }
+      return;
+    }
+
+    for (std::size_t i = 0; i < taken.count; i++) {
+      cache.entries[cache.count++] = taken.entries[i];
+    }
+  }
+
+  [[nodiscard]] static auto shared_depot() noexcept -> depot & {
+    // Never destroyed: threads may exit during static destruction
+    static auto *const instance = new depot;
+    return *instance;
+  }
+
+  [[nodiscard]] static auto this_thread_state() noexcept -> state & {
+    static constinit thread_local state current = state::uninitialized;
+    return current;
+  }
+
+  /// @brief This thread's cache, or `nullptr` if the thread is exiting.
+  [[nodiscard]] static auto this_thread_cache() noexcept -> thread_cache * {
+    static constinit thread_local thread_cache *current = nullptr;
+
+    if (current != nullptr and this_thread_state() == state::alive) {
+      return current;
+    }
+    if (this_thread_state() == state::destroyed) {
+      return nullptr;
+    }
+
+    thread_local thread_cache cache;
+    current = &cache;
+    this_thread_state() = state::alive;
+    return current;
+  }
+};
+
+} // namespace voidstar::detail::ffi
+
+#endif
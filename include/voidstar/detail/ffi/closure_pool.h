@@ -0,0 +1,272 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_FFI_CLOSURE_POOL_H
+#define VOIDSTAR_DETAIL_FFI_CLOSURE_POOL_H
+
+#include <voidstar/detail/ffi/cif.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/misc.h>
+
+#include <ffi.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail::ffi {
+
+/// @brief Tuning parameters of a `closure_pool`.
+struct closure_pool_options {
+  /// @brief A refill is requested when fewer trampolines than this are free.
+  std::size_t low_watermark = 64;
+
+  /// @brief The number of free trampolines a refill aims for.
+  std::size_t high_watermark = 256;
+
+  /// @brief Refill in a dedicated thread rather than on the acquiring thread.
+  bool background_refill = true;
+};
+
+/// @brief Bound to pooled trampolines that are not in use. Does nothing.
+inline void unbound_entrypoint(ffi_cif *, void *, void **, void *) {}
+
+/**
+ * @brief A free list of `ffi_closure`s prepared for @a call_signature.
+ *
+ * Free closures are prepared with the shared cif of @a call_signature and an
+ * entrypoint that does nothing. Handing one out only requires rewriting its
+ * `fun` and `user_data` fields, which involves no libffi calls and no syscalls.
+ */
+template <typename call_signature> class closure_pool {
+private:
+  closure_pool_options m_options;
+
+  mutable std::mutex m_mutex;
+  std::vector<closure> m_free;
+  bool m_refill_requested = false;
+  std::condition_variable_any m_refill_needed;
+
+  // Must be the last member: the thread accesses all of the above
+  std::jthread m_refiller;
+
+public:
+  /**
+   * @brief Create a pool and fill it up to the high watermark.
+   *
+   * @throws voidstar::error if the initial trampolines could not be allocated.
+   */
+  explicit closure_pool(closure_pool_options options = {})
+      : m_options{options} {
+    reserve(m_options.high_watermark);
+
+    if (m_options.background_refill) {
+      m_refiller = std::jthread{[this](std::stop_token stop) { //
+        refill_loop(std::move(stop));
+      }};
+    }
+  }
+
+  /// @brief Pools are not copyable.
+  closure_pool(closure_pool const &) = delete;
+
+  /// @brief Pools are not copyable.
+  auto operator=(closure_pool const &) -> closure_pool & = delete;
+
+  /// @brief Pools are not movable.
+  closure_pool(closure_pool &&) = delete;
+
+  /// @brief Pools are not movable.
+  auto operator=(closure_pool &&) -> closure_pool & = delete;
+
+  /**
+   * @brief Take a prepared closure from the free list.
+   *
+   * Falls back to preparing a new closure on the calling thread if the free
+   * list is empty.
+   *
+   * @throws voidstar::error if the free list is empty and a new closure could
+   * not be prepared.
+   */
+  [[nodiscard]] auto acquire() -> closure {
+    std::unique_lock lock{m_mutex};
+
+    if (m_free.empty()) {
+      lock.unlock();
+      return make_prepared();
+    }
+
+    closure result = std::move(m_free.back());
+    m_free.pop_back();
+
+    if (m_free.size() < m_options.low_watermark) {
+      if (m_options.background_refill) {
+        if (not m_refill_requested) {
+          m_refill_requested = true;
+          m_refill_needed.notify_one();
+        }
+      } else {
+        lock.unlock();
+        reserve(m_options.high_watermark);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Return @a released to the free list.
+   *
+   * The closure is freed instead if the free list cannot grow.
+   */
+  void release(closure released) noexcept {
+    released.raw()->fun = &unbound_entrypoint;
+    released.raw()->user_data = nullptr;
+
+    std::lock_guard const lock{m_mutex};
+    try {
+      m_free.push_back(std::move(released));
+    } catch (...) {
+      // Drop the closure
+    }
+  }
+
+  /**
+   * @brief Free closures until at most @a keep remain in the free list.
+   *
+   * The closures are returned to libffi directly rather than to the
+   * `closure_cache`.
+   */
+  void trim(std::size_t keep = 0) noexcept {
+    std::vector<closure> excess;
+    {
+      std::lock_guard const lock{m_mutex};
+      if (m_free.size() <= keep) {
+        return;
+      }
+
+      auto const first = m_free.begin() + static_cast<std::ptrdiff_t>(keep);
+      excess.assign(std::make_move_iterator(first),
+                    std::make_move_iterator(m_free.end()));
+      m_free.erase(first, m_free.end());
+    }
+
+    // Outside of the lock
+    for (auto &c : excess) {
+      std::move(c).free_uncached();
+    }
+  }
+
+  /**
+   * @brief Prepare closures until at least @a count are in the free list.
+   *
+   * @throws voidstar::error if a closure could not be prepared.
+   */
+  void reserve(std::size_t count) {
+    std::size_t const missing = [&] {
+      std::lock_guard const lock{m_mutex};
+      return m_free.size() < count ? count - m_free.size() : 0;
+    }();
+
+    if (missing == 0) {
+      return;
+    }
+
+    std::vector<closure> fresh;
+    fresh.reserve(missing);
+    for (std::size_t i = 0; i < missing; i++) {
+      fresh.push_back(make_prepared());
+    }
+
+    std::lock_guard const lock{m_mutex};
+    m_free.reserve(m_free.size() + fresh.size());
+    for (auto &c : fresh) {
+      m_free.push_back(std::move(c));
+    }
+  }
+
+  /// @brief The number of closures in the free list.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    std::lock_guard const lock{m_mutex};
+    return m_free.size();
+  }
+
+private:
+  [[nodiscard]] static auto make_prepared() -> closure {
+    closure result;
+    result.bind(shared_cif<call_signature>(), &unbound_entrypoint, nullptr);
+    return result;
+  }
+
+  void refill_loop(std::stop_token stop) {
+    while (true) {
+      {
+        std::unique_lock lock{m_mutex};
+        if (not m_refill_needed.wait(lock, stop,
+                                     [&] { return m_refill_requested; })) {
+          return;
+        }
+        // Acquisitions during the refill may request another one
+        m_refill_requested = false;
+      }
+
+      try {
+        reserve(m_options.high_watermark);
+      } catch (...) {
+        // Allocation will be retried synchronously by acquire()
+      }
+    }
+  }
+};
+
+/**
+ * @brief A trampoline that is borrowed from a @a pool and returned to it on
+ * destruction.
+ *
+ * @tparam pool A `closure_pool` instantiation.
+ */
+template <typename pool> class pooled_trampoline {
+private:
+  closure m_closure;
+  pool *m_pool;
+
+public:
+  explicit pooled_trampoline(pool &source)
+      : m_closure{source.acquire()}, m_pool{&source} {}
+
+  pooled_trampoline(pooled_trampoline const &) = delete;
+  auto operator=(pooled_trampoline const &) -> pooled_trampoline & = delete;
+
+  ~pooled_trampoline() { m_pool->release(std::move(m_closure)); }
+
+  /**
+   * @brief Redirect the trampoline to @a fun with @a user_data.
+   *
+   * The closure has already been prepared with the shared cif of the pool's
+   * call signature, which must be @a cif.
+   */
+  void bind(ffi_cif *cif, entrypoint_type *fun, void *user_data) noexcept {
+    (void)cif;
+    m_closure.raw()->fun = fun;
+    m_closure.raw()->user_data = user_data;
+  }
+
+  /// @brief Get type-erased function pointer to the trampoline.
+  [[nodiscard]] auto executable_ptr() const noexcept -> void * {
+    return m_closure.executable_ptr();
+  }
+
+  /// @brief The number of bytes of trampoline code at `executable_ptr()`.
+  [[nodiscard]] static constexpr auto code_size() noexcept -> std::size_t {
+    return closure::code_size();
+  }
+};
+
+} // namespace voidstar::detail::ffi
+
+#endif
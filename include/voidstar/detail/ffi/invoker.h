@@ -0,0 +1,145 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_FFI_INVOKER_H
+#define VOIDSTAR_DETAIL_FFI_INVOKER_H
+
+#include <voidstar/detail/ffi/cif.h>
+#include <voidstar/detail/misc.h>
+
+#include <ffi.h>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+
+namespace voidstar::detail::ffi {
+
+/**
+ * @brief Storage for a return value of type @a R written by `ffi_call`.
+ *
+ * libffi widens integral return values to `ffi_arg` and may write whole
+ * registers for small structs, so the buffer is never smaller than a register.
+ */
+template <typename R> class return_buffer {
+private:
+  static constexpr bool is_widened =
+      (std::integral<R> or std::is_enum_v<R>) and sizeof(R) < sizeof(ffi_arg);
+
+  alignas(std::max(alignof(R), alignof(ffi_arg))) std::byte
+      m_storage[std::max(sizeof(R), sizeof(ffi_arg))];
+
+public:
+  /// @brief Pointer to pass to `ffi_call` as `rvalue`.
+  [[nodiscard]] auto raw() noexcept -> void * { return m_storage; }
+
+  /// @brief The value written by `ffi_call`.
+  [[nodiscard]] auto value() noexcept -> R {
+    if constexpr (is_widened) {
+      using U = typename std::conditional_t<std::is_enum_v<R>,
+                                            std::underlying_type<R>,
+                                            std::type_identity<R>>::type;
+      using widened =
+          std::conditional_t<std::is_signed_v<U>, ffi_sarg, ffi_arg>;
+      return static_cast<R>(
+          *std::launder(reinterpret_cast<widened *>(m_storage)));
+    } else {
+      return *std::launder(reinterpret_cast<R *>(m_storage));
+    }
+  }
+};
+
+// Implementation of invoker is greatly shortened if argument types are a pack
+template <typename call_signature, typename arg_types> class invoker_impl;
+
+template <typename call_signature, typename... A>
+class invoker_impl<call_signature, std::tuple<A...>> {
+public:
+  /// @brief Pointer-to-function type that this invoker calls.
+  using fn_ptr_type = typename call_signature::fn_ptr_type;
+
+  /// @brief Return type of the called functions.
+  using return_type = typename call_signature::return_type;
+
+private:
+  static constexpr bool is_void = std::same_as<return_type, void>;
+
+  using arg_ptr_list = std::array<void *, call_signature::arg_count>;
+
+  ffi_cif *m_cif;
+
+  /// @brief Call @a fn with arguments pointed to by @a arg_ptrs.
+  auto call(fn_ptr_type fn, void **arg_ptrs) const -> return_type {
+    if constexpr (is_void) {
+      ffi_call(m_cif, FFI_FN(fn), nullptr, arg_ptrs);
+    } else {
+      return_buffer<return_type> result;
+      ffi_call(m_cif, FFI_FN(fn), result.raw(), arg_ptrs);
+      return result.value();
+    }
+  }
+
+public:
+  /**
+   * @brief Look up or prepare the shared cif for @a call_signature.
+   *
+   * @throws voidstar::error if the cif could not be prepared.
+   */
+  invoker_impl() : m_cif{shared_cif<call_signature>()} {}
+
+  /**
+   * @brief Call @a fn with @a args.
+   *
+   * Arguments are packed in this stack frame; no memory is allocated.
+   */
+  auto operator()(fn_ptr_type fn, A... args) const -> return_type {
+    arg_ptr_list arg_ptrs{static_cast<void *>(&args)...};
+    return call(fn, arg_ptrs.data());
+  }
+
+  /**
+   * @brief Call every function in @a fns with the same @a args, in order.
+   *
+   * Arguments are packed once and reused for every call.
+   */
+  void call_each(std::span<fn_ptr_type const> fns, A... args) const
+      requires is_void {
+    arg_ptr_list arg_ptrs{static_cast<void *>(&args)...};
+    for (auto fn : fns) {
+      call(fn, arg_ptrs.data());
+    }
+  }
+
+  /**
+   * @brief Call every function in @a fns with the same @a args, in order,
+   * storing the result of `fns[i]` in `results[i]`.
+   *
+   * Arguments are packed once and reused for every call. @a results must be at
+   * least as long as @a fns.
+   */
+  void call_each(std::span<fn_ptr_type const> fns,
+                 std::span<return_type> results, A... args) const
+      requires(not is_void) {
+    arg_ptr_list arg_ptrs{static_cast<void *>(&args)...};
+    for (std::size_t i = 0; i < fns.size(); i++) {
+      results[i] = call(fns[i], arg_ptrs.data());
+    }
+  }
+};
+
+/**
+ * @brief Calls C function pointers with @a call_signature through the shared
+ * cif.
+ */
+template <typename call_signature>
+using invoker =
+    invoker_impl<call_signature, typename call_signature::arg_types>;
+
+} // namespace voidstar::detail::ffi
+
+#endif
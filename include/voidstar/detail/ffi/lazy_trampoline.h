@@ -0,0 +1,129 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_FFI_LAZY_TRAMPOLINE_H
+#define VOIDSTAR_DETAIL_FFI_LAZY_TRAMPOLINE_H
+
+#include <voidstar/detail/ffi/closure.h>
+
+#include <ffi.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+namespace voidstar::detail::ffi {
+
+/**
+ * @brief A trampoline that constructs and binds a @a T on first access to
+ * `executable_ptr()`.
+ *
+ * Binding only records the target. Once prepared, `executable_ptr()` is a
+ * single acquire load; preparation itself is serialized by one of a small set
+ * of process-wide mutexes.
+ *
+ * @tparam T The trampoline to prepare lazily. Must be default-constructible.
+ */
+template <trampoline T>
+requires std::default_initializable<T>
+class lazy_trampoline {
+private:
+  mutable std::atomic<void *> m_executable_ptr{nullptr};
+  mutable std::optional<T> m_trampoline;
+
+  ffi_cif *m_cif = nullptr;
+  entrypoint_type *m_fun = nullptr;
+  void *m_thunk = nullptr;
+  void *m_user_data = nullptr;
+
+public:
+  lazy_trampoline() = default;
+
+  lazy_trampoline(lazy_trampoline const &) = delete;
+  auto operator=(lazy_trampoline const &) -> lazy_trampoline & = delete;
+
+  /// @brief Record the target for `T::bind`.
+  void bind(ffi_cif *cif, entrypoint_type *fun, void *user_data) noexcept
+  requires binds_entrypoint<T> and (not binds_thunk<T>)
+  {
+    m_cif = cif;
+    m_fun = fun;
+    m_user_data = user_data;
+  }
+
+  /// @brief Record the target for `T::bind_thunk`.
+  void bind_thunk(void *thunk, void *user_data) noexcept
+  requires binds_thunk<T>
+  {
+    m_thunk = thunk;
+    m_user_data = user_data;
+  }
+
+  /**
+   * @brief Get type-erased function pointer to the trampoline, preparing it
+   * if necessary.
+   *
+   * @throws voidstar::error if the trampoline could not be prepared. The next
+   * call will try again.
+   */
+  [[nodiscard]] auto executable_ptr() const -> void * {
+    if (auto *const ready = m_executable_ptr.load(std::memory_order_acquire);
+        ready != nullptr) {
+      return ready;
+    }
+    return prepare();
+  }
+
+  /// @brief The code size of the prepared trampoline, 0 until it is prepared.
+  [[nodiscard]] auto code_size() const noexcept -> std::size_t {
+    return is_prepared() ? m_trampoline->code_size() : 0;
+  }
+
+  /// @brief `true` if the trampoline has been prepared.
+  [[nodiscard]] auto is_prepared() const noexcept -> bool {
+    return m_executable_ptr.load(std::memory_order_acquire) != nullptr;
+  }
+
+private:
+  [[nodiscard]] auto prepare() const -> void * {
+    std::lock_guard const lock{preparation_mutex(this)};
+
+    if (auto *const ready = m_executable_ptr.load(std::memory_order_relaxed);
+        ready != nullptr) {
+      return ready;
+    }
+
+    auto &prepared = m_trampoline.emplace();
+    try {
+      if constexpr (binds_thunk<T>) {
+        prepared.bind_thunk(m_thunk, m_user_data);
+      } else {
+        prepared.bind(m_cif, m_fun, m_user_data);
+      }
+    } catch (...) {
+      m_trampoline.reset();
+      throw;
+    }
+
+    auto *const result = prepared.executable_ptr();
+    m_executable_ptr.store(result, std::memory_order_release);
+    return result;
+  }
+
+  /// @brief Striped locks: lazy closures are expected to be numerous and
+  /// rarely prepared, so they do not carry a mutex each.
+  [[nodiscard]] static auto preparation_mutex(void const *owner) noexcept
+      -> std::mutex & {
+    static constinit std::array<std::mutex, 16> mutexes{};
+    auto const hash = std::hash<void const *>{}(owner) / alignof(T);
+    return mutexes[hash % mutexes.size()];
+  }
+};
+
+} // namespace voidstar::detail::ffi
+
+#endif
@@ -6,6 +6,10 @@
 
 #include <voidstar/detail/misc.h>
 
+#include <ffi.h>
+
+#include <type_traits>
+
 namespace voidstar::detail::ffi {
 
 /**
@@ -17,6 +21,29 @@ template <typename T> struct type_description {
   static_assert(dependent_false<T>::value, "This type is not supported");
 };
 
+/**
+ * @brief Process-wide description of @a T.
+ *
+ * Stateful descriptions (structs and arrays) only refer to other interned
+ * descriptions, so they are constant-initialized: no guard variables and no
+ * code runs on first use. They are trivially destructible, so pointers into
+ * them remain valid until the program exits.
+ */
+template <typename T>
+inline constinit type_description<T> interned_description{};
+
+/**
+ * @brief Process-wide `ffi_type *` for @a T.
+ */
+template <typename T>
+[[nodiscard]] constexpr auto interned_type() noexcept -> ffi_type * {
+  if constexpr (std::is_empty_v<type_description<T>>) {
+    return type_description<T>{}.raw();
+  } else {
+    return interned_description<T>.raw();
+  }
+}
+
 } // namespace voidstar::detail::ffi
 
 #endif
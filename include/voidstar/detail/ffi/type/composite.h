@@ -27,6 +27,14 @@ template <std::size_t N> struct member_list : std::array<ffi_type *, N + 1> {
     std::ranges::copy(values, this->data());
     (*this)[N] = nullptr;
   }
+
+  /// @brief Initialize the list with N copies of @a element and a terminator.
+  ///
+  /// Unlike a pack expansion, costs the same to compile for any N.
+  constexpr explicit member_list(ffi_type *element) noexcept {
+    std::fill_n(this->data(), N, element);
+    (*this)[N] = nullptr;
+  }
 };
 
 // Pointer-like types
@@ -55,8 +63,8 @@ class type_description<T> {
 private:
   static constexpr auto size = std::extent_v<T>;
 
-  type_description<std::remove_extent_t<T>> m_element;
-  member_list<size> m_member_list = {n_copies<size>(m_element.raw())};
+  member_list<size> m_member_list{
+      interned_type<std::remove_extent_t<T>>()};
   ffi_type m_raw{
       .size = sizeof(T),
       .alignment = alignof(T),
@@ -98,11 +106,8 @@ private:
                 "Unbounded arrays cannot be member types. Structs with "
                 "flexible array members (C99 feature) are not supported.");
 
-  std::tuple<type_description<M>...> m_members;
-
   member_list<size> m_member_list{
-      std::apply([](auto &...m) -> member_list<size> { return {{m.raw()...}}; },
-                 m_members)};
+      std::array<ffi_type *, size>{interned_type<M>()...}};
 
   ffi_type m_raw{
       .size = sizeof(T),
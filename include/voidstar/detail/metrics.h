@@ -0,0 +1,313 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_METRICS_H
+#define VOIDSTAR_DETAIL_METRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail::metrics {
+
+/// @brief A point-in-time copy of the call metrics of one or more closures.
+struct call_metrics {
+  /// @brief The number of latency histogram buckets.
+  static constexpr std::size_t bucket_count = 48;
+
+  /// @brief Completed and ongoing calls.
+  std::uint64_t calls = 0;
+
+  /// @brief The largest number of calls that were executing at the same time.
+  std::uint64_t max_concurrent_calls = 0;
+
+  /// @brief Total time spent in the payload by completed calls.
+  std::uint64_t total_nanoseconds = 0;
+
+  /**
+   * @brief Completed calls by payload execution time.
+   *
+   * Bucket 0 counts calls that took less than 1 ns; bucket @a i > 0 counts
+   * calls that took [2^(i-1), 2^i) ns. The last bucket also counts all longer
+   * calls.
+   */
+  std::array<std::uint64_t, bucket_count> latency_histogram{};
+
+  /**
+   * @brief Add counts from @a other to this snapshot.
+   *
+   * `max_concurrent_calls` becomes the larger of the two values.
+   */
+  auto operator+=(call_metrics const &other) noexcept -> call_metrics & {
+    calls += other.calls;
+    max_concurrent_calls =
+        std::max(max_concurrent_calls, other.max_concurrent_calls);
+    total_nanoseconds += other.total_nanoseconds;
+    for (std::size_t i = 0; i < bucket_count; i++) {
+      latency_histogram[i] += other.latency_histogram[i];
+    }
+    return *this;
+  }
+
+  /// @brief The histogram bucket for a call that took @a nanoseconds.
+  [[nodiscard]] static constexpr auto
+  bucket_of(std::uint64_t nanoseconds) noexcept -> std::size_t {
+    return std::min<std::size_t>(std::bit_width(nanoseconds),
+                                 bucket_count - 1);
+  }
+};
+
+class registry;
+
+/// @brief The assumed cache line size.
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief Live call counters of a single closure.
+ *
+ * All updates are relaxed atomic operations, so recording never blocks
+ * concurrent callers.
+ *
+ * The counters that every call updates first have a cache line of their own,
+ * and the registry links that other closures' registration updates are kept
+ * on a separate one, so neighbouring closures do not falsely share them.
+ */
+class alignas(cache_line_size) counters {
+private:
+  friend registry;
+
+  using clock = std::chrono::steady_clock;
+
+  alignas(cache_line_size) std::atomic<std::uint64_t> m_calls{0};
+  std::atomic<std::uint64_t> m_in_flight{0};
+  std::atomic<std::uint64_t> m_max_in_flight{0};
+
+  alignas(cache_line_size) std::atomic<std::uint64_t> m_total_nanoseconds{0};
+  std::array<std::atomic<std::uint64_t>, call_metrics::bucket_count>
+      m_histogram{};
+
+  // Guarded by the registry mutex
+  alignas(cache_line_size) counters *m_previous = nullptr;
+  counters *m_next = nullptr;
+
+public:
+  using time_point = clock::time_point;
+
+  /// @brief Record the start of a call.
+  [[nodiscard]] auto begin() noexcept -> time_point {
+    m_calls.fetch_add(1, std::memory_order_relaxed);
+
+    auto const in_flight =
+        m_in_flight.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto max = m_max_in_flight.load(std::memory_order_relaxed);
+    while (in_flight > max and not m_max_in_flight.compare_exchange_weak(
+                                   max, in_flight, std::memory_order_relaxed)) {
+    }
+
+    return clock::now();
+  }
+
+  /// @brief Record the end of a call that started at @a start.
+  void end(time_point start) noexcept {
+    auto const elapsed = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             start)
+            .count());
+
+    m_total_nanoseconds.fetch_add(elapsed, std::memory_order_relaxed);
+    m_histogram[call_metrics::bucket_of(elapsed)].fetch_add(
+        1, std::memory_order_relaxed);
+    m_in_flight.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the counters.
+   *
+   * Counters are read individually, so a snapshot taken during calls may be
+   * slightly inconsistent, e.g. `calls` may exceed the histogram total.
+   */
+  [[nodiscard]] auto snapshot() const noexcept -> call_metrics {
+    call_metrics result;
+    result.calls = m_calls.load(std::memory_order_relaxed);
+    result.max_concurrent_calls =
+        m_max_in_flight.load(std::memory_order_relaxed);
+    result.total_nanoseconds =
+        m_total_nanoseconds.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < call_metrics::bucket_count; i++) {
+      result.latency_histogram[i] =
+          m_histogram[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+};
+
+/// @brief Metrics of all closures with the same signature and payload type.
+struct metrics_record {
+  /// @brief The function pointer type of the closures.
+  std::type_index signature;
+
+  /// @brief The payload type of the closures.
+  std::type_index payload;
+
+  /// @brief The number of closures that currently exist.
+  std::size_t live_closures;
+
+  /// @brief Combined metrics of existing and destroyed closures.
+  call_metrics metrics;
+};
+
+/**
+ * @brief The process-wide list of instrumented closures.
+ *
+ * Live closures of each type are kept in an intrusive doubly linked list, so
+ * adding and removing a closure is O(1) apart from the type lookup. Metrics of
+ * destroyed closures are folded into per-type totals.
+ */
+class registry {
+private:
+  using key = std::pair<std::type_index, std::type_index>;
+
+  struct entry {
+    counters *live = nullptr;
+    std::size_t live_count = 0;
+    call_metrics destroyed;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<key, entry> m_entries;
+
+  registry() = default;
+
+public:
+  /**
+   * @brief The process-wide registry.
+   *
+   * It is never destroyed so that closures with static storage duration may
+   * unregister during static destruction.
+   */
+  [[nodiscard]] static auto instance() -> registry & {
+    static auto *const singleton = new registry{};
+    return *singleton;
+  }
+
+  registry(registry const &) = delete;
+  auto operator=(registry const &) -> registry & = delete;
+  registry(registry &&) = delete;
+  auto operator=(registry &&) -> registry & = delete;
+
+  /**
+   * @brief Start reporting @a live under @a signature and @a payload.
+   *
+   * @throws std::bad_alloc
+   */
+  void add(std::type_index signature, std::type_index payload,
+           counters *live) {
+    std::lock_guard const lock{m_mutex};
+    auto &e = m_entries[{signature, payload}];
+
+    live->m_previous = nullptr;
+    live->m_next = e.live;
+    if (e.live != nullptr) {
+      e.live->m_previous = live;
+    }
+    e.live = live;
+    e.live_count++;
+  }
+
+  /// @brief Stop reporting @a live and add its final values to the totals.
+  void remove(std::type_index signature, std::type_index payload,
+              counters *live) noexcept {
+    std::lock_guard const lock{m_mutex};
+    auto &e = m_entries.find({signature, payload})->second;
+    e.destroyed += live->snapshot();
+
+    if (live->m_previous != nullptr) {
+      live->m_previous->m_next = live->m_next;
+    } else {
+      e.live = live->m_next;
+    }
+    if (live->m_next != nullptr) {
+      live->m_next->m_previous = live->m_previous;
+    }
+    live->m_previous = live->m_next = nullptr;
+    e.live_count--;
+  }
+
+  /// @brief Snapshot the metrics of every signature and payload type pair.
+  [[nodiscard]] auto collect() const -> std::vector<metrics_record> {
+    std::lock_guard const lock{m_mutex};
+
+    std::vector<metrics_record> result;
+    result.reserve(m_entries.size());
+    for (auto const &[k, e] : m_entries) {
+      call_metrics total = e.destroyed;
+      for (auto const *live = e.live; live != nullptr; live = live->m_next) {
+        total += live->snapshot();
+      }
+      result.push_back({k.first, k.second, e.live_count, total});
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief Call hooks that record `call_metrics` of a closure with call
+ * signature @a C and payload type @a P.
+ */
+template <typename C, typename P> class recording_hooks {
+private:
+  counters m_counters;
+
+  static auto signature() noexcept -> std::type_index {
+    return typeid(typename C::fn_ptr_type);
+  }
+
+  static auto payload() noexcept -> std::type_index { return typeid(P); }
+
+public:
+  /// @throws std::bad_alloc
+  recording_hooks() {
+    registry::instance().add(signature(), payload(), &m_counters);
+  }
+
+  recording_hooks(recording_hooks const &) = delete;
+  auto operator=(recording_hooks const &) -> recording_hooks & = delete;
+
+  ~recording_hooks() {
+    registry::instance().remove(signature(), payload(), &m_counters);
+  }
+
+  /// @brief Copy the metrics of this closure.
+  [[nodiscard]] auto snapshot() const noexcept -> call_metrics {
+    return m_counters.snapshot();
+  }
+
+  class scope {
+  private:
+    counters &m_counters;
+    counters::time_point m_start;
+
+  public:
+    explicit scope(recording_hooks &hooks) noexcept
+        : m_counters{hooks.m_counters}, m_start{m_counters.begin()} {}
+
+    scope(scope const &) = delete;
+    auto operator=(scope const &) -> scope & = delete;
+
+    ~scope() { m_counters.end(m_start); }
+  };
+};
+
+} // namespace voidstar::detail::metrics
+
+#endif
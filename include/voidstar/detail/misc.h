@@ -47,30 +47,6 @@ template <typename> struct dependent_false : std::false_type {};
 template <std::integral auto V>
 static constexpr std::integral_constant<decltype(V), V> constant;
 
-/**
- * @brief Apply @a callable for constexpr indices 0, 1, ... @a N-1.
- *
- * ```c++
- * auto lambda = [](auto... i) { int array[i + ...]; };
- * with_indices_zero_thru<5>(lambda); // Instantiates int[0 + 1 + 2 + 3 + 4]
- * ```
- */
-template <std::size_t N, typename C>
-static constexpr auto with_indices_zero_thru(C &&callable) {
-  return std::invoke(
-      [&]<std::size_t... I>(std::index_sequence<I...>) {
-        return std::invoke(std::forward<C>(callable), constant<I>...);
-      },
-      std::make_index_sequence<N>());
-}
-
-/// @brief Create a `std::array<T, N>` filled with copies of @a value.
-template <std::size_t N, typename T>
-static constexpr auto n_copies(T value) -> std::array<T, N> {
-  return with_indices_zero_thru<N>(
-      [&](auto... i) { return std::array{((void)i, T{value})...}; });
-}
-
 } // namespace voidstar::detail
 
 #endif
@@ -0,0 +1,187 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_MPSC_RING_H
+#define VOIDSTAR_DETAIL_MPSC_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar::detail {
+
+/**
+ * @brief A bounded lock-free queue of @a T with any number of producers and a
+ * single consumer.
+ *
+ * Each cell carries a sequence number that tells producers and the consumer
+ * whose turn it is, so neither side takes a lock and producers only contend
+ * on the enqueue position.
+ */
+template <typename T> class mpsc_ring {
+  static_assert(std::is_nothrow_move_constructible_v<T>);
+
+private:
+  static constexpr std::size_t cache_line = 64;
+
+  struct cell {
+    std::atomic<std::size_t> sequence;
+    alignas(T) std::byte storage[sizeof(T)];
+
+    [[nodiscard]] auto value() noexcept -> T * {
+      return std::launder(reinterpret_cast<T *>(storage));
+    }
+  };
+
+  std::unique_ptr<cell[]> m_cells;
+  std::size_t m_mask;
+
+  alignas(cache_line) std::atomic<std::size_t> m_enqueue_pos{0};
+
+  /// @brief Only written by the consumer.
+  alignas(cache_line) std::atomic<std::size_t> m_dequeue_pos{0};
+
+public:
+  /**
+   * @brief Allocate a ring for at least @a capacity elements.
+   *
+   * The capacity is rounded up to a power of two, and to at least 2.
+   *
+   * @throws std::bad_alloc if memory could not be allocated.
+   */
+  explicit mpsc_ring(std::size_t capacity)
+      : m_cells{std::make_unique<cell[]>(
+            std::bit_ceil(std::max(capacity, std::size_t{2})))},
+        m_mask{std::bit_ceil(std::max(capacity, std::size_t{2})) - 1} {
+    for (std::size_t i = 0; i <= m_mask; i++) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpsc_ring(mpsc_ring const &) = delete;
+  auto operator=(mpsc_ring const &) -> mpsc_ring & = delete;
+
+  ~mpsc_ring() {
+    consume([](T &&) {}, capacity());
+  }
+
+  /**
+   * @brief Construct an element from @a args at the tail of the queue.
+   *
+   * May be called by any thread.
+   *
+   * @return `false` if the queue is full.
+   */
+  template <typename... A> auto try_emplace(A &&...args) noexcept -> bool {
+    static_assert(std::is_nothrow_constructible_v<T, A...>);
+
+    auto pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    cell *target;
+
+    while (true) {
+      target = &m_cells[pos & m_mask];
+      auto const sequence = target->sequence.load(std::memory_order_acquire);
+      auto const lag = static_cast<std::ptrdiff_t>(sequence - pos);
+
+      if (lag == 0) {
+        if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1,
+                                                std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        return false;
+      } else {
+        pos = m_enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    ::new (target->storage) T(std::forward<A>(args)...);
+    target->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Move up to @a max elements from the head of the queue into
+   * @a handler, oldest first.
+   *
+   * Must only be called by the consumer. If @a handler throws, the element it
+   * was given is consumed and the exception propagates.
+   *
+   * @return The number of elements consumed.
+   */
+  template <typename H>
+  requires std::invocable<H &, T &&>
+  auto consume(H &&handler, std::size_t max) -> std::size_t {
+    auto pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    std::size_t consumed = 0;
+
+    // Publish progress once per batch, even on exceptions
+    struct publish {
+      mpsc_ring *ring;
+      std::size_t const *pos;
+      ~publish() {
+        ring->m_dequeue_pos.store(*pos, std::memory_order_seq_cst);
+      }
+    } const guard{this, &pos};
+
+    for (; consumed < max; consumed++) {
+      auto &source = m_cells[pos & m_mask];
+      if (source.sequence.load(std::memory_order_acquire) != pos + 1) {
+        break;
+      }
+
+      auto *const value = source.value();
+      auto release = [&]() noexcept {
+        std::destroy_at(value);
+        source.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        pos++;
+      };
+
+      try {
+        std::invoke(handler, std::move(*value));
+      } catch (...) {
+        release();
+        throw;
+      }
+      release();
+    }
+
+    return consumed;
+  }
+
+  /// @brief The number of elements the queue can hold.
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+    return m_mask + 1;
+  }
+
+  /// @brief The number of queued elements. Exact only when no thread is
+  /// modifying the queue.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    auto const dequeued = m_dequeue_pos.load(std::memory_order_acquire);
+    auto const enqueued = m_enqueue_pos.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  /// @brief A counter that the consumer advances after each batch.
+  [[nodiscard]] auto dequeue_position() const noexcept -> std::size_t {
+    return m_dequeue_pos.load(std::memory_order_seq_cst);
+  }
+
+  /// @brief Block until `dequeue_position()` differs from @a seen.
+  void wait_for_dequeue(std::size_t seen) const noexcept {
+    m_dequeue_pos.wait(seen, std::memory_order_seq_cst);
+  }
+
+  /// @brief Wake all threads in `wait_for_dequeue`.
+  void notify_dequeued() noexcept { m_dequeue_pos.notify_all(); }
+};
+
+} // namespace voidstar::detail
+
+#endif
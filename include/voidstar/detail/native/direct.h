@@ -0,0 +1,113 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_NATIVE_DIRECT_H
+#define VOIDSTAR_DETAIL_NATIVE_DIRECT_H
+
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/native/executable_memory.h>
+#include <voidstar/detail/native/x86_64.h>
+
+#include <cstddef>
+#include <type_traits>
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY and VOIDSTAR_HAS_SYSV_X86_64
+#define VOIDSTAR_HAS_DIRECT_TRAMPOLINES 1
+#else
+#define VOIDSTAR_HAS_DIRECT_TRAMPOLINES 0
+#endif
+
+namespace voidstar::detail::native {
+
+/**
+ * @brief `true` when closures with @a call_signature can use a
+ * `direct_trampoline` on this platform.
+ *
+ * A direct trampoline passes the arguments to a thunk with the exact C
+ * signature plus a trailing context pointer. This requires every argument and
+ * the return value to live in a single register, and a free general purpose
+ * register for the context.
+ */
+template <typename call_signature>
+concept supports_direct =
+    bool{VOIDSTAR_HAS_DIRECT_TRAMPOLINES} and
+    x86_64::can_append_context<typename call_signature::return_type,
+                               typename call_signature::arg_types>::value;
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+
+/**
+ * @brief A trampoline that bypasses libffi by loading the context pointer into
+ * the next free argument register and jumping to a typed thunk.
+ *
+ * Arguments are never spilled to memory: the thunk receives them in the same
+ * registers the caller put them in.
+ */
+template <typename call_signature>
+requires supports_direct<call_signature>
+class direct_trampoline {
+private:
+  static constexpr auto context_register =
+      x86_64::argument_registers[x86_64::integer_argument_count<
+          typename call_signature::arg_types>::value];
+
+  static_assert(x86_64::context_stub_size <= stub_allocator::slot_size);
+
+  stub_slot m_slot;
+  std::size_t m_code_size = 0;
+
+public:
+  /**
+   * @brief Allocate a stub.
+   *
+   * @throws voidstar::error if executable memory could not be obtained.
+   */
+  direct_trampoline() : m_slot{stub_allocator::instance().allocate()} {}
+
+  direct_trampoline(direct_trampoline const &) = delete;
+  auto operator=(direct_trampoline const &) -> direct_trampoline & = delete;
+
+  ~direct_trampoline() { stub_allocator::instance().deallocate(m_slot); }
+
+  /**
+   * @brief Emit a stub that calls `thunk(args..., user_data)`.
+   */
+  void bind_thunk(void *thunk, void *user_data) noexcept {
+    m_code_size = x86_64::emit_context_stub(
+        m_slot.writable, m_slot.executable, context_register, user_data, thunk);
+  }
+
+  /// @brief Get type-erased function pointer to the trampoline.
+  [[nodiscard]] auto executable_ptr() const noexcept -> void * {
+    return m_slot.executable;
+  }
+
+  /// @brief The number of bytes of the emitted stub.
+  [[nodiscard]] auto code_size() const noexcept -> std::size_t {
+    return m_code_size;
+  }
+};
+
+#endif
+
+/// @brief Selects `direct_trampoline` when possible, `ffi::closure` otherwise.
+template <typename call_signature> struct select_direct_trampoline {
+  using type = ffi::closure;
+};
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+template <typename call_signature>
+requires supports_direct<call_signature>
+struct select_direct_trampoline<call_signature> {
+  using type = direct_trampoline<call_signature>;
+};
+#endif
+
+/// @brief `direct_trampoline` when possible, `ffi::closure` otherwise.
+template <typename call_signature>
+using direct_or_ffi_trampoline =
+    typename select_direct_trampoline<call_signature>::type;
+
+} // namespace voidstar::detail::native
+
+#endif
@@ -0,0 +1,461 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_NATIVE_EXECUTABLE_MEMORY_H
+#define VOIDSTAR_DETAIL_NATIVE_EXECUTABLE_MEMORY_H
+
+#include <voidstar/error.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define VOIDSTAR_HAS_EXECUTABLE_MEMORY 1
+#else
+#define VOIDSTAR_HAS_EXECUTABLE_MEMORY 0
+#endif
+
+namespace voidstar::detail::native {
+
+/// @brief Executable memory could not be obtained.
+struct executable_memory_error : voidstar::error {
+  using voidstar::error::error;
+};
+
+/**
+ * @brief A fixed-size piece of executable memory for one stub.
+ *
+ * The same memory is mapped twice: @a writable is used to emit code, while @a
+ * executable is the address the code runs at. Neither mapping is both writable
+ * and executable.
+ */
+struct stub_slot {
+  std::byte *writable = nullptr;
+  void *executable = nullptr;
+};
+
+/**
+ * @brief A snapshot of the executable memory mapped by voidstar itself.
+ *
+ * Trampolines allocated by libffi are not included.
+ */
+struct executable_memory_stats {
+  /// @brief Bytes currently mapped, counting both views of a mapping once.
+  std::size_t mapped_bytes = 0;
+
+  /// @brief `mapped_bytes` in units of the base page size.
+  std::size_t mapped_pages = 0;
+
+  /// @brief Bytes of `mapped_bytes` that transparent huge pages were
+  /// requested for. The kernel may still back them with base pages.
+  std::size_t huge_page_bytes = 0;
+
+  /// @brief Bytes of `mapped_bytes` that are executable within reach of a
+  /// 32-bit relative jump from the program text.
+  std::size_t near_text_bytes = 0;
+
+  /// @brief Stubs handed out by the process-wide stub allocator.
+  std::size_t stubs_in_use = 0;
+
+  /// @brief Stubs that fit into the memory mapped by the stub allocator.
+  /// `stubs_in_use / stub_capacity` is how densely live stubs are packed.
+  std::size_t stub_capacity = 0;
+};
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+
+/// @brief Size and alignment of a transparent huge page.
+inline constexpr std::size_t huge_page_size = std::size_t{2} * 1024 * 1024;
+
+/**
+ * @brief Distance from the program text within which executable mappings are
+ * considered near.
+ *
+ * Half of the reach of a 32-bit relative jump, leaving the other half for the
+ * size of the text itself.
+ */
+inline constexpr std::uintptr_t near_text_distance = std::uintptr_t{1} << 30;
+
+/// @brief Process-wide counters behind `executable_memory_stats`.
+struct memory_counters {
+  std::atomic<std::size_t> mapped_bytes{0};
+  std::atomic<std::size_t> huge_page_bytes{0};
+  std::atomic<std::size_t> near_text_bytes{0};
+  std::atomic<std::size_t> stubs_in_use{0};
+  std::atomic<std::size_t> stub_capacity{0};
+
+  [[nodiscard]] auto snapshot() const noexcept -> executable_memory_stats {
+    auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    auto const mapped = mapped_bytes.load(std::memory_order_relaxed);
+    return {
+        .mapped_bytes = mapped,
+        .mapped_pages = mapped / page,
+        .huge_page_bytes = huge_page_bytes.load(std::memory_order_relaxed),
+        .near_text_bytes = near_text_bytes.load(std::memory_order_relaxed),
+        .stubs_in_use = stubs_in_use.load(std::memory_order_relaxed),
+        .stub_capacity = stub_capacity.load(std::memory_order_relaxed),
+    };
+  }
+};
+
+inline constinit memory_counters global_memory_counters;
+
+/// @brief An address in the program text near which stubs are placed.
+[[nodiscard]] inline auto text_anchor() noexcept -> void const * {
+  // Code that calls into voidstar thunks lives next to this function
+  return reinterpret_cast<void const *>(&text_anchor);
+}
+
+/// @brief `true` if [@a begin, @a begin + @a size) lies near @a anchor.
+[[nodiscard]] inline auto is_near(void const *begin, std::size_t size,
+                                  void const *anchor) noexcept -> bool {
+  auto const low = reinterpret_cast<std::uintptr_t>(begin);
+  auto const high = low + size;
+  auto const at = reinterpret_cast<std::uintptr_t>(anchor);
+  return (low >= at ? high - at : at - low) <= near_text_distance;
+}
+
+/// @brief How `map_twice` should place and back a mapping.
+struct mapping_options {
+  /// @brief Align the mapping to and request transparent huge pages.
+  bool huge_pages = false;
+
+  /// @brief Try to place the executable view near this address.
+  void const *near = nullptr;
+};
+
+/// @brief The two views of a piece of memory mapped by `map_twice`.
+struct double_mapping {
+  std::byte *writable = nullptr;
+  void *executable = nullptr;
+  std::size_t size = 0;
+
+  /// @brief Transparent huge pages were requested for both views.
+  bool huge_pages = false;
+
+  /// @brief The executable view is near the requested address.
+  bool near_text = false;
+};
+
+/**
+ * @brief Map the read-execute view of @a fd near @a anchor.
+ *
+ * Probes aligned addresses below and then above @a anchor.
+ *
+ * @return The mapping, or `MAP_FAILED` if no free address nearby was found.
+ */
+[[nodiscard]] inline auto map_executable_near(int fd, std::size_t size,
+                                              std::size_t alignment,
+                                              void const *anchor) noexcept
+    -> void * {
+  constexpr int probes = 64;
+
+  auto const at = reinterpret_cast<std::uintptr_t>(anchor) / alignment *
+                  alignment;
+  auto const step = (size + alignment - 1) / alignment * alignment;
+
+#ifdef MAP_FIXED_NOREPLACE
+  constexpr int flags = MAP_SHARED | MAP_FIXED_NOREPLACE;
+#else
+  constexpr int flags = MAP_SHARED;
+#endif
+
+  for (int direction : {-1, 1}) {
+    for (int i = 1; i <= probes; i++) {
+      auto const offset = static_cast<std::uintptr_t>(i) * step;
+      if (offset > near_text_distance / 2 or (direction < 0 and offset > at)) {
+        break;
+      }
+      auto const hint = direction < 0 ? at - offset : at + offset;
+
+      void *const result =
+          ::mmap(reinterpret_cast<void *>(hint), size, PROT_READ | PROT_EXEC,
+                 flags, fd, 0);
+      if (result == MAP_FAILED) {
+        continue;
+      }
+      if (is_near(result, size, anchor)) {
+        return result;
+      }
+      // Old kernels treat unknown flags as a plain hint
+      ::munmap(result, size);
+    }
+  }
+  return MAP_FAILED;
+}
+
+/**
+ * @brief Map @a size bytes of a new `memfd` twice, once read-write and once
+ * read-execute.
+ *
+ * @a size must be a multiple of the page size, and of `huge_page_size` if
+ * huge pages are requested. The memory is zero-filled. Placement and huge
+ * pages are best effort; the result records which were achieved.
+ *
+ * @throws executable_memory_error if the memory could not be mapped.
+ */
+[[nodiscard]] inline auto map_twice(std::size_t size,
+                                    mapping_options options = {})
+    -> double_mapping {
+  int const fd = ::memfd_create("voidstar", MFD_CLOEXEC);
+  if (fd < 0) {
+    throw executable_memory_error{"memfd_create failed"};
+  }
+
+  void *writable = MAP_FAILED;
+  void *executable = MAP_FAILED;
+  bool near_text = false;
+
+  if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+    writable =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (options.near != nullptr) {
+      auto const alignment =
+          options.huge_pages
+              ? huge_page_size
+              : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      executable = map_executable_near(fd, size, alignment, options.near);
+      near_text = executable != MAP_FAILED;
+    }
+    if (executable == MAP_FAILED) {
+      executable =
+          ::mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    }
+  }
+  ::close(fd);
+
+  if (writable == MAP_FAILED or executable == MAP_FAILED) {
+    if (writable != MAP_FAILED) {
+      ::munmap(writable, size);
+    }
+    if (executable != MAP_FAILED) {
+      ::munmap(executable, size);
+    }
+    throw executable_memory_error{"Could not map executable memory"};
+  }
+
+  bool huge_pages = false;
+#ifdef MADV_HUGEPAGE
+  if (options.huge_pages) {
+    // Only takes effect where shmem_enabled allows it
+    huge_pages = ::madvise(writable, size, MADV_HUGEPAGE) == 0 and
+                 ::madvise(executable, size, MADV_HUGEPAGE) == 0;
+  }
+#endif
+
+  auto &counters = global_memory_counters;
+  counters.mapped_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (huge_pages) {
+    counters.huge_page_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+  if (near_text) {
+    counters.near_text_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  return {
+      .writable = static_cast<std::byte *>(writable),
+      .executable = executable,
+      .size = size,
+      .huge_pages = huge_pages,
+      .near_text = near_text,
+  };
+}
+
+/// @brief Undo `map_twice`. Does nothing for empty mappings.
+inline void unmap_twice(double_mapping const &mapping) noexcept {
+  if (mapping.size == 0) {
+    return;
+  }
+  ::munmap(mapping.writable, mapping.size);
+  ::munmap(mapping.executable, mapping.size);
+
+  auto &counters = global_memory_counters;
+  counters.mapped_bytes.fetch_sub(mapping.size, std::memory_order_relaxed);
+  if (mapping.huge_pages) {
+    counters.huge_page_bytes.fetch_sub(mapping.size,
+                                       std::memory_order_relaxed);
+  }
+  if (mapping.near_text) {
+    counters.near_text_bytes.fetch_sub(mapping.size,
+                                       std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Process-wide allocator of `stub_slot`s.
+ *
+ * Stubs are carved from huge-page-sized regions of a `memfd` that is mapped
+ * twice, once read-write and once read-execute. Regions are placed near the
+ * program text where possible, so that stubs can reach their targets with
+ * 32-bit relative jumps, and are never returned to the OS. Freed stubs are
+ * reused before a region is extended, which keeps live stubs packed into as
+ * few pages as possible.
+ */
+class stub_allocator {
+public:
+  /// @brief Size and alignment of every slot.
+  static constexpr std::size_t slot_size = 32;
+
+  /// @brief Size of every region mapping.
+  static constexpr std::size_t region_size = huge_page_size;
+
+private:
+  std::mutex m_mutex;
+  std::vector<stub_slot> m_free;
+
+  /// @brief The region that new slots are carved from.
+  double_mapping m_region;
+  std::size_t m_region_offset = 0;
+
+  stub_allocator() = default;
+
+public:
+  stub_allocator(stub_allocator const &) = delete;
+  auto operator=(stub_allocator const &) -> stub_allocator & = delete;
+
+  /// @brief The process-wide instance.
+  [[nodiscard]] static auto instance() -> stub_allocator & {
+    // Never destroyed: stubs may be used during static destruction
+    static auto *const allocator = new stub_allocator;
+    return *allocator;
+  }
+
+  /**
+   * @brief Take a free slot, mapping a new region if necessary.
+   *
+   * @throws executable_memory_error if a new region could not be mapped.
+   */
+  [[nodiscard]] auto allocate() -> stub_slot {
+    std::lock_guard const lock{m_mutex};
+
+    stub_slot result;
+    if (not m_free.empty()) {
+      result = m_free.back();
+      m_free.pop_back();
+    } else {
+      if (m_region_offset == m_region.size) {
+        map_region();
+      }
+      result = stub_slot{
+          .writable = m_region.writable + m_region_offset,
+          .executable =
+              static_cast<std::byte *>(m_region.executable) + m_region_offset,
+      };
+      m_region_offset += slot_size;
+    }
+
+    global_memory_counters.stubs_in_use.fetch_add(1,
+                                                  std::memory_order_relaxed);
+    return result;
+  }
+
+  /// @brief Return @a slot to the free list.
+  void deallocate(stub_slot slot) noexcept {
+    std::lock_guard const lock{m_mutex};
+    try {
+      m_free.push_back(slot);
+    } catch (...) {
+      // Leak the slot
+    }
+    global_memory_counters.stubs_in_use.fetch_sub(1,
+                                                  std::memory_order_relaxed);
+  }
+
+private:
+  // Requires m_mutex
+  void map_region() {
+    m_region = map_twice(region_size, {.huge_pages = true,
+                                       .near = text_anchor()});
+    m_region_offset = 0;
+    global_memory_counters.stub_capacity.fetch_add(
+        region_size / slot_size, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief An owning double mapping of executable memory of arbitrary size.
+ *
+ * Unlike `stub_allocator` regions, the memory is unmapped on destruction.
+ */
+class executable_block {
+private:
+  double_mapping m_mapping;
+
+public:
+  /// @brief An empty block.
+  executable_block() noexcept = default;
+
+  /**
+   * @brief Map at least @a size bytes of zero-filled memory.
+   *
+   * With `options.huge_pages`, the size is rounded up to a multiple of
+   * `huge_page_size` instead of the base page size.
+   *
+   * @throws executable_memory_error if the memory could not be mapped.
+   */
+  explicit executable_block(std::size_t size, mapping_options options = {})
+      : m_mapping{map_twice(round_up(size, options), options)} {}
+
+  executable_block(executable_block const &) = delete;
+  auto operator=(executable_block const &) -> executable_block & = delete;
+
+  executable_block(executable_block &&other) noexcept
+      : m_mapping{std::exchange(other.m_mapping, {})} {}
+
+  auto operator=(executable_block &&other) noexcept -> executable_block & {
+    std::swap(m_mapping, other.m_mapping);
+    return *this;
+  }
+
+  ~executable_block() { unmap_twice(m_mapping); }
+
+  /// @brief The base address of the read-write view.
+  [[nodiscard]] auto writable() const noexcept -> std::byte * {
+    return m_mapping.writable;
+  }
+
+  /// @brief The base address of the read-execute view.
+  [[nodiscard]] auto executable() const noexcept -> void * {
+    return m_mapping.executable;
+  }
+
+  /// @brief The size of each view in bytes.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return m_mapping.size;
+  }
+
+  /// @brief `true` if transparent huge pages were requested for the block.
+  [[nodiscard]] auto huge_pages() const noexcept -> bool {
+    return m_mapping.huge_pages;
+  }
+
+  /// @brief `true` if the executable view was placed near the requested
+  /// address.
+  [[nodiscard]] auto near_text() const noexcept -> bool {
+    return m_mapping.near_text;
+  }
+
+private:
+  [[nodiscard]] static auto round_up(std::size_t size,
+                                     mapping_options const &options)
+      -> std::size_t {
+    auto const page =
+        options.huge_pages ? huge_page_size
+                           : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return (std::max(size, std::size_t{1}) + page - 1) / page * page;
+  }
+};
+
+#endif
+
+} // namespace voidstar::detail::native
+
+#endif
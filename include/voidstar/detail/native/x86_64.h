@@ -0,0 +1,168 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_NATIVE_X86_64_H
+#define VOIDSTAR_DETAIL_NATIVE_X86_64_H
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__x86_64__) and not defined(_WIN32)
+#define VOIDSTAR_HAS_SYSV_X86_64 1
+#else
+#define VOIDSTAR_HAS_SYSV_X86_64 0
+#endif
+
+namespace voidstar::detail::native::x86_64 {
+
+////////////////////////////////////////////////////////////////////////////////
+// System V AMD64 ABI classification
+//
+
+/// @brief Scalar types passed in a general purpose register (INTEGER class).
+template <typename T>
+concept integer_class =
+    (std::is_integral_v<T> and sizeof(T) <= 8) or std::is_enum_v<T> or
+    std::is_pointer_v<T>;
+
+/// @brief Scalar types passed in a vector register (SSE class).
+template <typename T>
+concept sse_class = std::same_as<T, float> or std::same_as<T, double>;
+
+/// @brief Types that are passed and returned in a single register.
+template <typename T>
+concept register_scalar = integer_class<T> or sse_class<T>;
+
+/// @brief General purpose registers used for arguments, in order.
+enum class gp_register : std::uint8_t {
+  rdi = 7,
+  rsi = 6,
+  rdx = 2,
+  rcx = 1,
+  r8 = 8,
+  r9 = 9,
+};
+
+inline constexpr std::array<gp_register, 6> argument_registers{
+    gp_register::rdi, gp_register::rsi, gp_register::rdx,
+    gp_register::rcx, gp_register::r8,  gp_register::r9,
+};
+
+/// @brief Number of INTEGER class types in @a arg_types.
+template <typename arg_types> struct integer_argument_count;
+
+template <typename... A>
+struct integer_argument_count<std::tuple<A...>>
+    : std::integral_constant<std::size_t,
+                             (0 + ... + (integer_class<A> ? 1 : 0))> {};
+
+/**
+ * @brief `true` when an extra pointer appended to the parameters of
+ * `R(A...)` is passed in a register and the other arguments stay in place.
+ */
+template <typename R, typename arg_types> struct can_append_context;
+
+template <typename R, typename... A>
+struct can_append_context<R, std::tuple<A...>>
+    : std::bool_constant<
+          (std::is_void_v<R> or register_scalar<R>) and
+          (... and register_scalar<A>) and
+          integer_argument_count<std::tuple<A...>>::value <
+              argument_registers.size()> {};
+
+////////////////////////////////////////////////////////////////////////////////
+// Code generation
+//
+
+/// @brief Maximum size of the code emitted by `emit_context_stub`.
+inline constexpr std::size_t context_stub_size = 27;
+
+/// @brief Size of the code emitted by `emit_context_stub` when the target is
+/// within reach of a relative jump.
+inline constexpr std::size_t near_context_stub_size = 19;
+
+/**
+ * @brief Emit a stub that loads @a context into @a reg and jumps to @a target.
+ *
+ * If @a target is within reach of a 32-bit displacement from the end of the
+ * stub at @a at:
+ *
+ * ```
+ * endbr64
+ * movabs reg, context
+ * jmp    target
+ * ```
+ *
+ * Otherwise:
+ *
+ * ```
+ * endbr64
+ * movabs reg, context
+ * movabs r11, target
+ * jmp    r11
+ * ```
+ *
+ * @param out Writable memory of at least `context_stub_size` bytes.
+ * @param at The address the stub will execute at.
+ *
+ * @return The number of bytes emitted.
+ */
+inline auto emit_context_stub(std::byte *out, void const *at, gp_register reg,
+                              void *context, void *target) noexcept
+    -> std::size_t {
+  auto *const begin = out;
+  auto const reg_index = static_cast<std::uint8_t>(reg);
+  auto const ctx_bits = std::bit_cast<std::uint64_t>(context);
+  auto const target_bits = std::bit_cast<std::uint64_t>(target);
+
+  auto emit = [&](std::initializer_list<std::uint8_t> bytes) {
+    for (auto byte : bytes) {
+      *out++ = static_cast<std::byte>(byte);
+    }
+  };
+  auto emit_u64 = [&](std::uint64_t value) {
+    std::memcpy(out, &value, sizeof(value));
+    out += sizeof(value);
+  };
+
+  // endbr64
+  emit({0xF3, 0x0F, 0x1E, 0xFA});
+
+  // movabs reg, imm64: REX.W[.B] B8+r
+  emit({static_cast<std::uint8_t>(reg_index >= 8 ? 0x49 : 0x48),
+        static_cast<std::uint8_t>(0xB8 + (reg_index & 7))});
+  emit_u64(ctx_bits);
+
+  // Wrapping arithmetic: the displacement is relative to the next instruction
+  auto const next = std::bit_cast<std::uint64_t>(at) +
+                    static_cast<std::uint64_t>(out - begin) + 5;
+  auto const displacement = static_cast<std::int64_t>(target_bits - next);
+
+  if (displacement >= INT32_MIN and displacement <= INT32_MAX) {
+    // jmp rel32
+    auto const rel32 = static_cast<std::int32_t>(displacement);
+    emit({0xE9});
+    std::memcpy(out, &rel32, sizeof(rel32));
+    out += sizeof(rel32);
+  } else {
+    // movabs r11, imm64
+    emit({0x49, 0xBB});
+    emit_u64(target_bits);
+
+    // jmp r11
+    emit({0x41, 0xFF, 0xE3});
+  }
+
+  return static_cast<std::size_t>(out - begin);
+}
+
+} // namespace voidstar::detail::native::x86_64
+
+#endif
@@ -0,0 +1,370 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_QUEUED_CLOSURE_H
+#define VOIDSTAR_DETAIL_QUEUED_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/mpsc_ring.h>
+#include <voidstar/error.h>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#define VOIDSTAR_HAS_EVENTFD 1
+#else
+#define VOIDSTAR_HAS_EVENTFD 0
+#endif
+
+namespace voidstar::detail {
+
+/// @brief What a queued closure does when its queue is full.
+enum class overflow_policy {
+  /// @brief Discard the call and return the rejected result.
+  drop,
+
+  /// @brief Wait in the calling thread until the consumer makes room.
+  block,
+};
+
+/// @brief Construction parameters of a queued closure returning @a R.
+template <typename R> struct queued_closure_options {
+  /// @brief The minimum number of calls the queue holds; rounded up to a
+  /// power of two.
+  std::size_t capacity = 1024;
+
+  /// @brief What to do when the queue is full.
+  overflow_policy on_overflow = overflow_policy::drop;
+
+  /// @brief Whether to signal an eventfd when calls become available.
+  bool eventfd = false;
+
+  /// @brief Returned to the C caller when its call was queued.
+  R accepted_result{};
+
+  /// @brief Returned to the C caller when its call was dropped.
+  R rejected_result{};
+};
+
+/// @brief Construction parameters of a queued closure returning nothing.
+template <> struct queued_closure_options<void> {
+  /// @brief The minimum number of calls the queue holds; rounded up to a
+  /// power of two.
+  std::size_t capacity = 1024;
+
+  /// @brief What to do when the queue is full.
+  overflow_policy on_overflow = overflow_policy::drop;
+
+  /// @brief Whether to signal an eventfd when calls become available.
+  bool eventfd = false;
+};
+
+/// @brief A snapshot of the counters of a queued closure.
+struct queue_stats {
+  /// @brief The number of calls waiting to be drained.
+  std::size_t depth = 0;
+
+  /// @brief The number of calls the queue holds.
+  std::size_t capacity = 0;
+
+  /// @brief The number of calls drained so far.
+  std::uint64_t drained = 0;
+
+  /// @brief The number of calls discarded because the queue was full.
+  std::uint64_t dropped = 0;
+
+  /// @brief The number of calls that waited because the queue was full.
+  std::uint64_t blocked = 0;
+};
+
+/**
+ * @brief A C callback that copies its arguments into a bounded lock-free
+ * queue for a single consumer thread.
+ *
+ * Any number of threads may invoke the callback. The queue holds
+ * `std::tuple<A...>` by value, so pointer arguments must outlive the drain.
+ * Only calls that make the queue non-empty wake the consumer.
+ *
+ * @tparam C Call signature of the callback.
+ * @tparam T Trampoline implementation.
+ */
+template <typename C, ffi::trampoline T,
+          typename arg_types = typename C::arg_types>
+class queued_closure_impl;
+
+template <typename C, ffi::trampoline T, typename... A>
+class queued_closure_impl<C, T, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  using entry = std::tuple<A...>;
+
+  /// @brief The payload of the trampoline.
+  struct enqueue {
+    queued_closure_impl *owner;
+
+    auto operator()(A... args) const noexcept -> return_type {
+      return owner->push(std::move(args)...);
+    }
+  };
+
+  using closure_type =
+      closure_impl<C, enqueue, T, default_call_hooks<C, enqueue>>;
+
+  static constexpr bool nothrow_get =
+      noexcept(std::declval<closure_type const &>().get());
+
+public:
+  /// @brief Type of the function pointer to hand to C code.
+  using fn_ptr_type = typename C::fn_ptr_type;
+
+  /// @brief Type of construction parameters.
+  using options_type = queued_closure_options<return_type>;
+
+private:
+  options_type m_options;
+  mpsc_ring<entry> m_ring;
+
+  /// @brief `true` once calls are available and the consumer has not yet
+  /// started draining them.
+  std::atomic<bool> m_signaled{false};
+
+  /// @brief Closes the eventfd even if a later member fails to initialize.
+  struct owned_fd {
+    int fd;
+
+    explicit owned_fd(int fd) noexcept : fd{fd} {}
+    owned_fd(owned_fd const &) = delete;
+    auto operator=(owned_fd const &) -> owned_fd & = delete;
+    ~owned_fd() { close_event_fd(fd); }
+  };
+
+  owned_fd m_event_fd;
+
+  std::atomic<std::uint64_t> m_drained{0};
+  std::atomic<std::uint64_t> m_dropped{0};
+  std::atomic<std::uint64_t> m_blocked{0};
+  std::atomic<std::uint32_t> m_waiting_producers{0};
+
+  closure_type m_closure;
+
+public:
+  /**
+   * @brief Allocate the queue and prepare a trampoline.
+   *
+   * @throws std::bad_alloc if the queue could not be allocated.
+   * @throws voidstar::error if the eventfd could not be created or the C
+   * function could not be generated.
+   */
+  explicit queued_closure_impl(options_type options = {})
+  requires std::default_initializable<T>
+      : m_options{std::move(options)}, m_ring{m_options.capacity},
+        m_event_fd{open_event_fd(m_options.eventfd)},
+        m_closure{enqueue{this}} {}
+
+  /**
+   * @brief Allocate the queue and obtain a trampoline from @a source, such
+   * as a `voidstar::closure_pool`.
+   *
+   * @throws std::bad_alloc if the queue could not be allocated.
+   * @throws voidstar::error if the eventfd could not be created or the C
+   * function could not be generated.
+   */
+  template <typename S>
+  requires std::constructible_from<T, S &>
+  explicit queued_closure_impl(S &source, options_type options = {})
+      : m_options{std::move(options)}, m_ring{m_options.capacity},
+        m_event_fd{open_event_fd(m_options.eventfd)},
+        m_closure{source, enqueue{this}} {}
+
+  queued_closure_impl(queued_closure_impl const &) = delete;
+  auto operator=(queued_closure_impl const &) -> queued_closure_impl & = delete;
+
+  /// @brief The C function that queues its arguments.
+  [[nodiscard]] auto get() const noexcept(nothrow_get) -> fn_ptr_type {
+    return m_closure.get();
+  }
+
+  /// @brief The C function that queues its arguments.
+  operator fn_ptr_type() const noexcept(nothrow_get) {
+    return get();
+  }
+
+  /**
+   * @brief Invoke @a handler with the arguments of up to @a max_batch queued
+   * calls, oldest first.
+   *
+   * Must only be called by one thread at a time. If @a handler throws, the
+   * call it was given is consumed and the exception propagates.
+   *
+   * @return The number of calls drained.
+   */
+  template <typename H>
+  requires std::invocable<H &, A...>
+  auto drain(H &&handler,
+             std::size_t max_batch = std::numeric_limits<std::size_t>::max())
+      -> std::size_t {
+    clear_event_fd();
+    m_signaled.exchange(false, std::memory_order_seq_cst);
+
+    std::size_t drained = 0;
+    try {
+      m_ring.consume(
+          [&](entry &&arguments) {
+            drained++;
+            std::apply(handler, std::move(arguments));
+          },
+          max_batch);
+    } catch (...) {
+      finish_batch(drained);
+      throw;
+    }
+    finish_batch(drained);
+    return drained;
+  }
+
+  /// @brief Block until calls may be available to drain.
+  void wait() const noexcept {
+    m_signaled.wait(false, std::memory_order_acquire);
+  }
+
+  /**
+   * @brief A non-blocking eventfd that becomes readable when calls are
+   * available, or -1 if the queue was not created with one.
+   *
+   * `drain()` resets it; do not read from it directly.
+   */
+  [[nodiscard]] auto event_fd() const noexcept -> int { return m_event_fd.fd; }
+
+  /// @brief A snapshot of the counters of the queue.
+  [[nodiscard]] auto stats() const noexcept -> queue_stats {
+    return {
+        .depth = m_ring.size(),
+        .capacity = m_ring.capacity(),
+        .drained = m_drained.load(std::memory_order_relaxed),
+        .dropped = m_dropped.load(std::memory_order_relaxed),
+        .blocked = m_blocked.load(std::memory_order_relaxed),
+    };
+  }
+
+private:
+  auto push(A... args) noexcept -> return_type {
+    if (not m_ring.try_emplace(std::move(args)...)) [[unlikely]] {
+      if (m_options.on_overflow == overflow_policy::drop) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return rejected();
+      }
+      wait_for_room(args...);
+    }
+
+    // Pairs with the exchange in drain(): either this thread sees that the
+    // consumer has started draining, or the consumer sees the new call
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (not m_signaled.load(std::memory_order_relaxed)) {
+      signal();
+    }
+    return accepted();
+  }
+
+  void wait_for_room(A &...args) noexcept {
+    m_blocked.fetch_add(1, std::memory_order_relaxed);
+    m_waiting_producers.fetch_add(1, std::memory_order_seq_cst);
+    while (true) {
+      auto const seen = m_ring.dequeue_position();
+      if (m_ring.try_emplace(std::move(args)...)) {
+        break;
+      }
+      m_ring.wait_for_dequeue(seen);
+    }
+    m_waiting_producers.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void signal() noexcept {
+    if (not m_signaled.exchange(true, std::memory_order_seq_cst)) {
+      m_signaled.notify_one();
+      write_event_fd();
+    }
+  }
+
+  void finish_batch(std::size_t drained) noexcept {
+    m_drained.fetch_add(drained, std::memory_order_relaxed);
+    if (m_waiting_producers.load(std::memory_order_seq_cst) != 0) {
+      m_ring.notify_dequeued();
+    }
+    if (m_ring.size() != 0) {
+      // Calls were left behind by max_batch or an exception
+      signal();
+    }
+  }
+
+  [[nodiscard]] auto accepted() const noexcept -> return_type {
+    if constexpr (not std::is_void_v<return_type>) {
+      return m_options.accepted_result;
+    }
+  }
+
+  [[nodiscard]] auto rejected() const noexcept -> return_type {
+    if constexpr (not std::is_void_v<return_type>) {
+      return m_options.rejected_result;
+    }
+  }
+
+  [[nodiscard]] static auto open_event_fd(bool requested) -> int {
+    if (not requested) {
+      return -1;
+    }
+#if VOIDSTAR_HAS_EVENTFD
+    auto const fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (fd < 0) {
+      throw voidstar::error{"eventfd failed"};
+    }
+    return fd;
+#else
+    throw voidstar::error{"eventfd is not supported on this platform"};
+#endif
+  }
+
+  static void close_event_fd(int fd) noexcept {
+#if VOIDSTAR_HAS_EVENTFD
+    if (fd >= 0) {
+      ::close(fd);
+    }
+#endif
+  }
+
+  void write_event_fd() const noexcept {
+#if VOIDSTAR_HAS_EVENTFD
+    if (m_event_fd.fd >= 0) {
+      std::uint64_t const one = 1;
+      [[maybe_unused]] auto const written =
+          ::write(m_event_fd.fd, &one, sizeof(one));
+    }
+#endif
+  }
+
+  void clear_event_fd() const noexcept {
+#if VOIDSTAR_HAS_EVENTFD
+    if (m_event_fd.fd >= 0) {
+      std::uint64_t value;
+      [[maybe_unused]] auto const read =
+          ::read(m_event_fd.fd, &value, sizeof(value));
+    }
+#endif
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -0,0 +1,95 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_REBINDABLE_H
+#define VOIDSTAR_DETAIL_REBINDABLE_H
+
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/reclaim.h>
+
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+namespace voidstar::detail {
+
+/**
+ * @brief A payload that forwards calls to a heap-allocated @a P that can be
+ * replaced while calls are in flight.
+ *
+ * Calls read the current target with an acquire load. Replaced targets are
+ * retired to the global `reclaim::reclaimer`, which destroys them once all
+ * calls tracked by `reclaim::in_flight_tracking` that could still see them
+ * have exited; the closure must therefore use those hooks, which add a
+ * sequentially consistent increment on entry and a release increment on exit
+ * to every call.
+ *
+ * @tparam C Call signature.
+ * @tparam P The type of targets.
+ */
+template <typename C, typename P, typename arg_types = typename C::arg_types>
+class rebindable;
+
+template <typename C, typename P, typename... A>
+class rebindable<C, P, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  std::atomic<P *> m_current;
+
+public:
+  /**
+   * @brief Allocate the first target, forwarding @a args to its constructor.
+   *
+   * Starts the reclaimer thread if it is not running yet.
+   *
+   * @throws Any exception thrown by the target constructor or by `new`.
+   * @throws std::system_error if the reclaimer thread could not be started.
+   */
+  template <typename... S>
+  requires std::constructible_from<P, S...>
+  explicit rebindable(S &&...args)
+      : m_current{((void)reclaim::reclaimer::instance(),
+                   new P(std::forward<S>(args)...))} {}
+
+  rebindable(rebindable const &) = delete;
+  auto operator=(rebindable const &) -> rebindable & = delete;
+
+  /// @brief Destroy the current target immediately; no calls may be in
+  /// flight.
+  ~rebindable() { delete m_current.load(std::memory_order_relaxed); }
+
+  auto operator()(A... args) -> return_type {
+    return std::invoke(*m_current.load(std::memory_order_acquire),
+                       std::move(args)...);
+  }
+
+  /**
+   * @brief Replace the target with one constructed from @a args.
+   *
+   * Calls that start after this function returns use the new target. The old
+   * target is destroyed in the background once calls that may use it have
+   * exited. May be called concurrently with calls and other rebinds, including
+   * from within the target.
+   *
+   * @throws Any exception thrown by the target constructor or by `new`; the
+   * current target is kept in that case.
+   */
+  template <typename... S>
+  requires std::constructible_from<P, S...>
+  void rebind(S &&...args) {
+    auto *const replacement = new P(std::forward<S>(args)...);
+    auto *const old =
+        m_current.exchange(replacement, std::memory_order_seq_cst);
+    reclaim::reclaimer::instance().retire(old, [](void *retired) noexcept {
+      delete static_cast<P *>(retired);
+    });
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -0,0 +1,295 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_RECLAIM_H
+#define VOIDSTAR_DETAIL_RECLAIM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail::reclaim {
+
+/**
+ * @brief Tracks calls in flight and waits for them to exit, in the manner of
+ * sleepable RCU.
+ *
+ * Readers increment one of two counter pairs selected by the parity of the
+ * current epoch. `synchronize()` flips the epoch and waits for the counters of
+ * the previous parity to balance, so it only waits for readers that entered
+ * before it was called.
+ *
+ * Counters are sharded by thread to keep concurrent readers off each other's
+ * cache lines.
+ */
+class domain {
+public:
+  /// @brief The number of counter shards.
+  static constexpr std::size_t shard_count = 32;
+
+private:
+  struct alignas(64) shard {
+    std::array<std::atomic<std::uint64_t>, 2> entered{};
+    std::array<std::atomic<std::uint64_t>, 2> exited{};
+  };
+
+  std::array<shard, shard_count> m_shards{};
+  std::atomic<std::uint64_t> m_epoch{0};
+
+  /// @brief Serializes grace periods.
+  std::mutex m_synchronize_mutex;
+
+public:
+  /// @brief Identifies the counter to decrement when a reader exits.
+  struct token {
+    shard *counters;
+    std::size_t parity;
+  };
+
+  constexpr domain() = default;
+
+  domain(domain const &) = delete;
+  auto operator=(domain const &) -> domain & = delete;
+  domain(domain &&) = delete;
+  auto operator=(domain &&) -> domain & = delete;
+
+  /// @brief Mark the calling thread as in flight until `exit()`.
+  [[nodiscard]] auto enter() noexcept -> token {
+    auto &counters = m_shards[this_thread_shard()];
+    auto const parity =
+        static_cast<std::size_t>(m_epoch.load(std::memory_order_relaxed) & 1);
+
+    // Full barrier: the reader's accesses cannot move above the increment
+    counters.entered[parity].fetch_add(1, std::memory_order_seq_cst);
+    return {&counters, parity};
+  }
+
+  /// @brief End the critical section started by the `enter()` call that
+  /// returned @a entered.
+  void exit(token entered) noexcept {
+    entered.counters->exited[entered.parity].fetch_add(
+        1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Block until every reader that entered before this call has exited.
+   *
+   * Readers that enter during the call are not waited for.
+   */
+  void synchronize() noexcept {
+    std::lock_guard const lock{m_synchronize_mutex};
+
+    auto const parity =
+        static_cast<std::size_t>(m_epoch.load(std::memory_order_relaxed) & 1);
+
+    // Readers that loaded the epoch before the previous flip but incremented
+    // the counters after it may still be counted under the other parity
+    wait_until_drained(parity ^ 1);
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    wait_until_drained(parity);
+  }
+
+  /// @brief The domain that tracks all retirable closures.
+  [[nodiscard]] static auto global() noexcept -> domain &;
+
+private:
+  [[nodiscard]] static auto this_thread_shard() noexcept -> std::size_t {
+    static constinit std::atomic<std::size_t> next{0};
+    thread_local std::size_t const index =
+        next.fetch_add(1, std::memory_order_relaxed) % shard_count;
+    return index;
+  }
+
+  [[nodiscard]] auto drained(std::size_t parity) const noexcept -> bool {
+    std::uint64_t exited = 0;
+    for (auto const &counters : m_shards) {
+      exited += counters.exited[parity].load(std::memory_order_acquire);
+    }
+
+    // Exits are summed before entries, so a reader that enters and exits
+    // between the two sums can only make the counters look unbalanced
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::uint64_t entered = 0;
+    for (auto const &counters : m_shards) {
+      entered += counters.entered[parity].load(std::memory_order_relaxed);
+    }
+
+    return entered == exited;
+  }
+
+  void wait_until_drained(std::size_t parity) const noexcept {
+    using namespace std::chrono_literals;
+
+    auto delay = 1us;
+    for (int spin = 0; not drained(parity); spin++) {
+      if (spin < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(delay);
+        delay = std::min(delay * 2, std::chrono::microseconds{1ms});
+      }
+    }
+  }
+};
+
+inline constinit domain global_domain{};
+
+inline auto domain::global() noexcept -> domain & { return global_domain; }
+
+/**
+ * @brief Call hooks that mark each call as in flight in the global domain.
+ *
+ * The count is an `entry_scope`: it starts at the top of the entry point that
+ * libffi or a native stub jumps to, before the closure object or its
+ * trampoline memory is read by voidstar, and ends when the entry point
+ * returns. Retired closures, including their trampolines, are destroyed only
+ * after a grace period, so they outlive every counted call.
+ */
+struct in_flight_tracking {
+  class entry_scope {
+  private:
+    domain::token m_token;
+
+  public:
+    entry_scope() noexcept : m_token{domain::global().enter()} {}
+
+    entry_scope(entry_scope const &) = delete;
+    auto operator=(entry_scope const &) -> entry_scope & = delete;
+
+    ~entry_scope() { domain::global().exit(m_token); }
+  };
+
+  struct scope {
+    explicit scope(in_flight_tracking & /* hooks */) noexcept {}
+  };
+};
+
+/**
+ * @brief Destroys retired objects in a background thread once the calls that
+ * were in flight at the time of retirement have exited.
+ */
+class reclaimer {
+public:
+  /// @brief Type-erased deleter of a retired object.
+  using destroy_fn = void(void *) noexcept;
+
+private:
+  struct retired {
+    void *object;
+    destroy_fn *destroy;
+  };
+
+  std::mutex m_mutex;
+  std::vector<retired> m_pending;
+  std::uint64_t m_retired_count = 0;
+  std::uint64_t m_reclaimed_count = 0;
+  std::condition_variable_any m_pending_added;
+  std::condition_variable m_batch_reclaimed;
+
+  // Must be the last member: the thread accesses all of the above
+  std::jthread m_worker;
+
+  reclaimer() {
+    m_worker = std::jthread{[this](std::stop_token stop) { //
+      reclaim_loop(std::move(stop));
+    }};
+  }
+
+public:
+  /**
+   * @brief The process-wide reclaimer.
+   *
+   * It is never destroyed so that closures may be retired during static
+   * destruction.
+   */
+  [[nodiscard]] static auto instance() -> reclaimer & {
+    static auto *const singleton = new reclaimer{};
+    return *singleton;
+  }
+
+  reclaimer(reclaimer const &) = delete;
+  auto operator=(reclaimer const &) -> reclaimer & = delete;
+  reclaimer(reclaimer &&) = delete;
+  auto operator=(reclaimer &&) -> reclaimer & = delete;
+
+  /**
+   * @brief Schedule @a object to be passed to @a destroy after a grace period.
+   *
+   * Does not wait for the grace period, unless memory for the bookkeeping
+   * cannot be allocated, in which case the object is reclaimed synchronously.
+   */
+  void retire(void *object, destroy_fn *destroy) noexcept {
+    {
+      std::lock_guard const lock{m_mutex};
+      try {
+        m_pending.push_back({object, destroy});
+        m_retired_count++;
+        m_pending_added.notify_one();
+        return;
+      } catch (...) {
+        // Fall through to synchronous reclamation
+      }
+    }
+
+    domain::global().synchronize();
+    destroy(object);
+  }
+
+  /// @brief Block until every object retired before this call is destroyed.
+  void barrier() {
+    std::unique_lock lock{m_mutex};
+    auto const target = m_retired_count;
+    m_batch_reclaimed.wait(lock, [&] { return m_reclaimed_count >= target; });
+  }
+
+private:
+  void reclaim_loop(std::stop_token stop) {
+    std::vector<retired> batch;
+
+    while (true) {
+      {
+        std::unique_lock lock{m_mutex};
+        if (not m_pending_added.wait(lock, stop,
+                                     [&] { return not m_pending.empty(); })) {
+          return;
+        }
+        batch.swap(m_pending);
+      }
+
+      domain::global().synchronize();
+
+      for (auto const &entry : batch) {
+        entry.destroy(entry.object);
+      }
+
+      {
+        std::lock_guard const lock{m_mutex};
+        m_reclaimed_count += batch.size();
+      }
+      m_batch_reclaimed.notify_all();
+      batch.clear();
+    }
+  }
+};
+
+/// @brief A deleter that retires @a T instead of deleting it immediately.
+template <typename T> struct deferred_delete {
+  void operator()(T *object) const noexcept {
+    reclaimer::instance().retire(
+        object, [](void *retired) noexcept { delete static_cast<T *>(retired); });
+  }
+};
+
+} // namespace voidstar::detail::reclaim
+
+#endif
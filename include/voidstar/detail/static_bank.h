@@ -0,0 +1,195 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_STATIC_BANK_H
+#define VOIDSTAR_DETAIL_STATIC_BANK_H
+
+#include <voidstar/error.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace voidstar::detail {
+
+/// @brief All slots of a `static_bank` are in use.
+struct bank_exhausted_error : voidstar::error {
+  using voidstar::error::error;
+};
+
+/**
+ * @brief A process-wide set of @a capacity entry functions with the exact
+ * signature of @a call_signature, compiled ahead of time.
+ *
+ * Entry function `I` loads slot `I` of a context table and calls the
+ * `thunk(args..., user_data)` stored there. Slots are handed out by a
+ * lock-free bitmap allocator. No code is generated at runtime, so banks work
+ * where writable and executable mappings are forbidden.
+ *
+ * Each distinct @a call_signature and @a capacity has its own bank.
+ */
+template <typename call_signature, std::size_t capacity> class static_bank {
+  static_assert(capacity > 0);
+
+public:
+  using fn_ptr_type = typename call_signature::fn_ptr_type;
+
+private:
+  using return_type = typename call_signature::return_type;
+  using arg_types = typename call_signature::arg_types;
+
+  /**
+   * @brief The target of an entry function.
+   *
+   * Entry functions may run on any thread, so both pointers are atomic.
+   * `user_data` is stored before `thunk` is released, and entry functions
+   * acquire `thunk` before loading `user_data`.
+   */
+  struct context {
+    std::atomic<void *> thunk{nullptr};
+    std::atomic<void *> user_data{nullptr};
+  };
+
+  static constexpr std::size_t word_bits = 64;
+  static constexpr std::size_t word_count =
+      (capacity + word_bits - 1) / word_bits;
+
+  static constinit inline std::array<context, capacity> s_contexts{};
+  static constinit inline std::array<std::atomic<std::uint64_t>, word_count>
+      s_used{};
+
+  template <std::size_t I, typename tuple> struct entry;
+
+  template <std::size_t I, typename... A> struct entry<I, std::tuple<A...>> {
+    static auto invoke(A... args) -> return_type {
+      auto const &slot = s_contexts[I];
+      auto *const thunk = slot.thunk.load(std::memory_order_acquire);
+      return reinterpret_cast<return_type (*)(A..., void *)>(thunk)(
+          args..., slot.user_data.load(std::memory_order_relaxed));
+    }
+  };
+
+public:
+  static_bank() = delete;
+
+  /**
+   * @brief Reserve a free slot.
+   *
+   * @throws bank_exhausted_error if all @a capacity slots are in use.
+   */
+  [[nodiscard]] static auto acquire() -> std::size_t {
+    for (std::size_t word = 0; word < word_count; word++) {
+      auto &bits = s_used[word];
+      auto current = bits.load(std::memory_order_relaxed);
+
+      while (true) {
+        auto const bit = static_cast<std::size_t>(std::countr_one(current));
+        auto const slot = word * word_bits + bit;
+        if (bit == word_bits or slot >= capacity) {
+          break;
+        }
+
+        if (bits.compare_exchange_weak(current,
+                                       current | std::uint64_t{1} << bit,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed)) {
+          return slot;
+        }
+      }
+    }
+
+    throw bank_exhausted_error{"All " + std::to_string(capacity) +
+                               " slots of the static trampoline bank are "
+                               "in use"};
+  }
+
+  /// @brief Make @a slot available to `acquire()`.
+  static void release(std::size_t slot) noexcept {
+    s_used[slot / word_bits].fetch_and(
+        ~(std::uint64_t{1} << slot % word_bits), std::memory_order_release);
+  }
+
+  /**
+   * @brief Make entry function @a slot call `thunk(args..., user_data)`.
+   *
+   * Calls on other threads that observe the new thunk also observe
+   * @a user_data.
+   */
+  static void bind(std::size_t slot, void *thunk, void *user_data) noexcept {
+    auto &context = s_contexts[slot];
+    context.user_data.store(user_data, std::memory_order_relaxed);
+    context.thunk.store(thunk, std::memory_order_release);
+  }
+
+  /// @brief The entry function of @a slot.
+  [[nodiscard]] static auto entry_point(std::size_t slot) noexcept
+      -> fn_ptr_type {
+    static constexpr auto entries = []<std::size_t... I>(
+                                        std::index_sequence<I...>) {
+      return std::array<fn_ptr_type, capacity>{
+          &entry<I, arg_types>::invoke...};
+    }(std::make_index_sequence<capacity>{});
+
+    return entries[slot];
+  }
+
+  /// @brief The number of slots currently in use.
+  [[nodiscard]] static auto in_use() noexcept -> std::size_t {
+    std::size_t result = 0;
+    for (auto const &bits : s_used) {
+      result += static_cast<std::size_t>(
+          std::popcount(bits.load(std::memory_order_relaxed)));
+    }
+    return result;
+  }
+};
+
+/**
+ * @brief A trampoline that occupies one slot of a `static_bank`.
+ *
+ * @throws bank_exhausted_error on construction if the bank is full.
+ */
+template <typename call_signature, std::size_t capacity>
+class bank_trampoline {
+private:
+  using bank = static_bank<call_signature, capacity>;
+
+  std::size_t m_slot;
+
+public:
+  /**
+   * @brief Reserve a slot.
+   *
+   * @throws bank_exhausted_error if all slots of the bank are in use.
+   */
+  bank_trampoline() : m_slot{bank::acquire()} {}
+
+  bank_trampoline(bank_trampoline const &) = delete;
+  auto operator=(bank_trampoline const &) -> bank_trampoline & = delete;
+
+  ~bank_trampoline() { bank::release(m_slot); }
+
+  /// @brief Make the entry function call `thunk(args..., user_data)`.
+  void bind_thunk(void *thunk, void *user_data) noexcept {
+    bank::bind(m_slot, thunk, user_data);
+  }
+
+  /// @brief Get type-erased function pointer to the entry function.
+  [[nodiscard]] auto executable_ptr() const noexcept -> void * {
+    return reinterpret_cast<void *>(bank::entry_point(m_slot));
+  }
+
+  /// @brief 1: the size of the compiled entry function is not known.
+  [[nodiscard]] static constexpr auto code_size() noexcept -> std::size_t {
+    return 1;
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -0,0 +1,115 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_STATIC_CLOSURE_H
+#define VOIDSTAR_DETAIL_STATIC_CLOSURE_H
+
+#include <voidstar/detail/call_signature.h>
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+
+namespace voidstar::detail {
+
+/**
+ * @brief A payload without state: a default-constructed @a P behaves exactly
+ * like any other instance, so a statically compiled function can stand in
+ * for a trampoline.
+ */
+template <typename P>
+concept stateless_payload = std::is_empty_v<P> and
+                            std::is_trivially_default_constructible_v<P> and
+                            std::is_trivially_destructible_v<P>;
+
+/**
+ * @brief A trampoline that is a statically compiled function.
+ *
+ * Allocates nothing and involves no libffi calls. Only usable for stateless
+ * payloads and closures without call hooks, since the function receives no
+ * context. Only `stateless_closure` uses it.
+ */
+class static_trampoline {
+private:
+  void *m_function = nullptr;
+
+public:
+  static_trampoline() noexcept = default;
+
+  /// @brief Use @a function, which has the exact call signature of the
+  /// closure.
+  void bind_static(void *function) noexcept { m_function = function; }
+
+  /// @brief Get type-erased function pointer to the function.
+  [[nodiscard]] auto executable_ptr() const noexcept -> void * {
+    return m_function;
+  }
+
+  /// @brief 1: the size of the compiled function is not known.
+  [[nodiscard]] static constexpr auto code_size() noexcept -> std::size_t {
+    return 1;
+  }
+};
+
+/// @brief The function type that callable @a T is invoked as, if it has
+/// exactly one.
+template <typename T> struct callable_signature {};
+
+template <typename R, typename... A> struct callable_signature<R (*)(A...)> {
+  using type = R(A...);
+};
+
+template <typename R, typename... A>
+struct callable_signature<R (*)(A...) noexcept> {
+  using type = R(A...);
+};
+
+template <typename T>
+requires requires { &T::operator(); }
+struct callable_signature<T>
+    : callable_signature<decltype(&T::operator())> {};
+
+template <typename T, typename R, typename... A>
+struct callable_signature<R (T::*)(A...) const> {
+  using type = R(A...);
+};
+
+template <typename T, typename R, typename... A>
+struct callable_signature<R (T::*)(A...) const noexcept> {
+  using type = R(A...);
+};
+
+/**
+ * @brief A statically compiled function of call signature @a C that invokes
+ * the constant @a Callable.
+ *
+ * If @a Callable already is a pointer to a function of that signature, it is
+ * used as is.
+ */
+template <auto Callable, typename C,
+          typename arg_types = typename C::arg_types>
+struct constant_function;
+
+template <auto Callable, typename C, typename... A>
+struct constant_function<Callable, C, std::tuple<A...>> {
+  using return_type = typename C::return_type;
+  using fn_ptr_type = typename C::fn_ptr_type;
+
+  static auto thunk(A... args) -> return_type {
+    return static_cast<return_type>(std::invoke(Callable, args...));
+  }
+
+  static constexpr fn_ptr_type value = [] {
+    if constexpr (std::convertible_to<decltype(Callable), fn_ptr_type>) {
+      return static_cast<fn_ptr_type>(Callable);
+    } else {
+      return &thunk;
+    }
+  }();
+};
+
+} // namespace voidstar::detail
+
+#endif
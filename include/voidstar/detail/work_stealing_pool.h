@@ -0,0 +1,228 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_WORK_STEALING_POOL_H
+#define VOIDSTAR_DETAIL_WORK_STEALING_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::detail {
+
+/// @brief A unit of work queued in a `work_stealing_pool`.
+struct pool_task {
+  /// @brief Run and delete the task.
+  void (*run)(pool_task *) noexcept;
+};
+
+/**
+ * @brief A fixed set of worker threads, each with its own task deque.
+ *
+ * Workers run their own tasks newest first and, when out of work, steal the
+ * oldest tasks of other workers. Tasks submitted by a worker go to its own
+ * deque; tasks submitted by other threads are spread across workers round
+ * robin, so there is no central queue. Each deque has its own lock, which is
+ * only contended by thieves.
+ *
+ * Idle workers sleep until a task is submitted. The destructor runs all
+ * queued tasks before joining the workers.
+ */
+class work_stealing_pool {
+private:
+  struct alignas(64) worker_queue {
+    std::mutex mutex;
+    std::deque<pool_task *> tasks;
+  };
+
+  /// @brief The pool and worker index of the current thread, if any.
+  struct worker_identity {
+    work_stealing_pool const *pool = nullptr;
+    std::size_t index = 0;
+  };
+
+  std::unique_ptr<worker_queue[]> m_queues;
+  std::size_t m_size;
+
+  alignas(64) std::atomic<std::size_t> m_next_queue{0};
+
+  /// @brief Tasks submitted and not yet taken by a worker.
+  alignas(64) std::atomic<std::size_t> m_queued{0};
+
+  alignas(64) std::atomic<std::uint32_t> m_wake_epoch{0};
+  std::atomic<std::uint32_t> m_sleeping{0};
+  std::atomic<bool> m_stopping{false};
+
+  std::vector<std::jthread> m_workers;
+
+public:
+  /**
+   * @brief Start @a thread_count workers, or one per hardware thread if zero.
+   *
+   * @throws std::system_error if a thread could not be started.
+   */
+  explicit work_stealing_pool(std::size_t thread_count = 0)
+      : m_size{thread_count != 0
+                   ? thread_count
+                   : std::max(std::size_t{std::thread::hardware_concurrency()},
+                              std::size_t{1})} {
+    m_queues = std::make_unique<worker_queue[]>(m_size);
+    m_workers.reserve(m_size);
+    try {
+      for (std::size_t i = 0; i < m_size; i++) {
+        m_workers.emplace_back([this, i] { work(i); });
+      }
+    } catch (...) {
+      stop();
+      throw;
+    }
+  }
+
+  work_stealing_pool(work_stealing_pool const &) = delete;
+  auto operator=(work_stealing_pool const &) -> work_stealing_pool & = delete;
+
+  /// @brief Run all queued tasks and join the workers.
+  ~work_stealing_pool() { stop(); }
+
+  /**
+   * @brief Queue @a fun to run on a worker.
+   *
+   * @a fun must not throw; an escaping exception terminates the program.
+   *
+   * @throws std::bad_alloc if the task could not be queued.
+   */
+  template <typename F>
+  requires std::invocable<std::decay_t<F> &>
+  void submit(F &&fun) {
+    struct task : pool_task {
+      std::decay_t<F> fun;
+      explicit task(F &&fun)
+          : pool_task{&task::execute}, fun{std::forward<F>(fun)} {}
+
+      static void execute(pool_task *self) noexcept {
+        auto *const owned = static_cast<task *>(self);
+        std::invoke(owned->fun);
+        delete owned;
+      }
+    };
+
+    auto owned = std::make_unique<task>(std::forward<F>(fun));
+    enqueue(owned.get());
+    owned.release();
+  }
+
+  /// @brief `true` if the calling thread is a worker of this pool.
+  [[nodiscard]] auto running_in_this_thread() const noexcept -> bool {
+    return current_worker().pool == this;
+  }
+
+  /// @brief The number of workers.
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return m_size; }
+
+private:
+  [[nodiscard]] static auto current_worker() noexcept -> worker_identity & {
+    static constinit thread_local worker_identity current{};
+    return current;
+  }
+
+  void enqueue(pool_task *task) {
+    auto const &self = current_worker();
+    auto const index =
+        self.pool == this
+            ? self.index
+            : m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_size;
+
+    m_queued.fetch_add(1, std::memory_order_seq_cst);
+    try {
+      auto &queue = m_queues[index];
+      std::lock_guard const lock{queue.mutex};
+      queue.tasks.push_back(task);
+    } catch (...) {
+      m_queued.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+
+    if (m_sleeping.load(std::memory_order_seq_cst) != 0) {
+      m_wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+      m_wake_epoch.notify_one();
+    }
+  }
+
+  [[nodiscard]] auto pop(std::size_t index) noexcept -> pool_task * {
+    auto &queue = m_queues[index];
+    std::lock_guard const lock{queue.mutex};
+    if (queue.tasks.empty()) {
+      return nullptr;
+    }
+    auto *const task = queue.tasks.back();
+    queue.tasks.pop_back();
+    return task;
+  }
+
+  [[nodiscard]] auto steal(std::size_t thief) noexcept -> pool_task * {
+    for (std::size_t offset = 1; offset < m_size; offset++) {
+      auto &queue = m_queues[(thief + offset) % m_size];
+      std::unique_lock const lock{queue.mutex, std::try_to_lock};
+      if (lock.owns_lock() and not queue.tasks.empty()) {
+        auto *const task = queue.tasks.front();
+        queue.tasks.pop_front();
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  void work(std::size_t index) noexcept {
+    current_worker() = {.pool = this, .index = index};
+
+    while (true) {
+      auto *task = pop(index);
+      if (task == nullptr) {
+        task = steal(index);
+      }
+      if (task != nullptr) {
+        m_queued.fetch_sub(1, std::memory_order_relaxed);
+        task->run(task);
+        continue;
+      }
+
+      if (m_queued.load(std::memory_order_seq_cst) != 0) {
+        // A task is being pushed or its deque was locked by another thief
+        std::this_thread::yield();
+        continue;
+      }
+      if (m_stopping.load(std::memory_order_acquire)) {
+        return;
+      }
+
+      auto const epoch = m_wake_epoch.load(std::memory_order_seq_cst);
+      m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+      if (m_queued.load(std::memory_order_seq_cst) == 0 and
+          not m_stopping.load(std::memory_order_seq_cst)) {
+        m_wake_epoch.wait(epoch, std::memory_order_seq_cst);
+      }
+      m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  void stop() noexcept {
+    m_stopping.store(true, std::memory_order_seq_cst);
+    m_wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    m_wake_epoch.notify_all();
+    m_workers.clear();
+  }
+};
+
+} // namespace voidstar::detail
+
+#endif
@@ -0,0 +1,154 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DETAIL_WRAP_H
+#define VOIDSTAR_DETAIL_WRAP_H
+
+#include <voidstar/detail/call_signature.h>
+
+#include <concepts>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar::detail {
+
+/// @brief A decorator that takes over the whole call of an original function
+/// pointer @a Fn with arguments @a A.
+template <typename D, typename Fn, typename... A>
+concept around_decorator = std::invocable<D &, Fn, A...>;
+
+/// @brief A decorator with a `before(args...)` hook.
+template <typename D, typename... A>
+concept has_before = requires(D &decorator, A const &...args) {
+  decorator.before(args...);
+};
+
+/// @brief A decorator with an `after(args...)` hook for functions that
+/// return nothing.
+template <typename D, typename... A>
+concept has_void_after = requires(D &decorator, A const &...args) {
+  decorator.after(args...);
+};
+
+/// @brief A decorator with an `after(result, args...)` hook.
+template <typename D, typename R, typename... A>
+concept has_after = requires(D &decorator, R &result, A const &...args) {
+  decorator.after(result, args...);
+};
+
+/**
+ * @brief A payload that calls an original function pointer, running the hooks
+ * of decorator @a D around it.
+ *
+ * If @a D is invocable with the original function pointer followed by the
+ * arguments, it is responsible for the whole call. Otherwise its optional
+ * `before(args...)` member runs before the original, and its optional
+ * `after(result, args...)` (or `after(args...)` for `void` results) runs
+ * after it and may modify the result. Arguments are passed through unchanged.
+ *
+ * @tparam C Call signature of both the original and the wrapper.
+ * @tparam D The decorator.
+ */
+template <typename C, typename D, typename arg_types = typename C::arg_types>
+class decorated;
+
+template <typename C, typename D, typename... A>
+class decorated<C, D, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+  using fn_ptr_type = typename C::fn_ptr_type;
+
+  static constexpr bool is_around = around_decorator<D, fn_ptr_type, A...>;
+
+  static_assert(is_around or has_before<D, A...> or
+                    has_void_after<D, A...> or
+                    has_after<D, return_type, A...>,
+                "A decorator must be invocable with the original function and "
+                "the arguments, or have a before or after member");
+
+  fn_ptr_type m_original;
+  [[no_unique_address]] D m_decorator;
+
+public:
+  /// @brief Wrap @a original, constructing the decorator from @a args.
+  template <typename... S>
+  requires std::constructible_from<D, S...>
+  explicit decorated(fn_ptr_type original, S &&...args)
+      : m_original{original}, m_decorator(std::forward<S>(args)...) {}
+
+  auto operator()(A... args) -> return_type {
+    if constexpr (is_around) {
+      return static_cast<return_type>(
+          std::invoke(m_decorator, m_original, args...));
+    } else {
+      if constexpr (has_before<D, A...>) {
+        m_decorator.before(std::as_const(args)...);
+      }
+
+      if constexpr (std::is_void_v<return_type>) {
+        m_original(args...);
+        if constexpr (has_void_after<D, A...>) {
+          m_decorator.after(std::as_const(args)...);
+        }
+      } else if constexpr (has_after<D, return_type, A...>) {
+        auto result = m_original(args...);
+        m_decorator.after(result, std::as_const(args)...);
+        return result;
+      } else {
+        return m_original(args...);
+      }
+    }
+  }
+
+  /// @brief The wrapped function.
+  [[nodiscard]] auto original() const noexcept -> fn_ptr_type {
+    return m_original;
+  }
+
+  /// @brief The decorator.
+  [[nodiscard]] auto decorator() noexcept -> D & { return m_decorator; }
+
+  /// @brief The decorator.
+  [[nodiscard]] auto decorator() const noexcept -> D const & {
+    return m_decorator;
+  }
+};
+
+/**
+ * @brief A payload that calls function pointer @a G with bound leading
+ * arguments @a B followed by the arguments of call signature @a C.
+ */
+template <typename C, typename G, typename B,
+          typename arg_types = typename C::arg_types>
+class front_bound;
+
+template <typename C, typename G, typename... B, typename... A>
+class front_bound<C, G, std::tuple<B...>, std::tuple<A...>> {
+private:
+  using return_type = typename C::return_type;
+
+  G *m_original;
+  std::tuple<B...> m_bound;
+
+public:
+  /// @brief Bind @a bound in front of the arguments to @a original.
+  template <typename... S>
+  requires(sizeof...(S) == sizeof...(B))
+  explicit front_bound(G *original, S &&...bound)
+      : m_original{original}, m_bound{std::forward<S>(bound)...} {}
+
+  auto operator()(A... args) const -> return_type {
+    return static_cast<return_type>(std::apply(
+        [&](B const &...bound) { return m_original(bound..., args...); },
+        m_bound));
+  }
+
+  /// @brief The wrapped function.
+  [[nodiscard]] auto original() const noexcept -> G * { return m_original; }
+};
+
+} // namespace voidstar::detail
+
+#endif
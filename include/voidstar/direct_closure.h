@@ -0,0 +1,57 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DIRECT_CLOSURE_H
+#define VOIDSTAR_DIRECT_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/native/direct.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A [closure](#closure) that calls the payload without going through
+ * libffi when the call signature allows it.
+ *
+ * On x86-64 System V platforms, if all argument types and the return type are
+ * scalars or pointers, and there are at most five integer or pointer
+ * arguments, the trampoline loads the closure address into a spare argument
+ * register and jumps to a statically compiled thunk. Arguments stay in
+ * registers. For all other signatures and platforms, `direct_closure<F, P>`
+ * behaves exactly like `closure<F, P>`.
+ *
+ * @tparam F The desired call signature of the trampoline; either a function
+ * type or a pointer to function type.
+ *
+ * @tparam P A user-provided callable payload that should be invoked by the
+ * trampoline.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using direct_closure = detail::closure_impl<
+    detail::call_signature<F>, P,
+    detail::native::direct_or_ffi_trampoline<detail::call_signature<F>>>;
+
+/**
+ * @brief Constructs a new [direct_closure](#direct_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @param payload The object to invoke through the C function pointer. It is
+ * moved into the closure.
+ *
+ * @return Initialized closure containing a move-constructed payload.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_direct_closure(P payload) -> direct_closure<F, P> {
+  return direct_closure<F, P>{std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,68 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_DISPATCHED_CLOSURE_H
+#define VOIDSTAR_DISPATCHED_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/dispatched_closure.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/work_stealing_pool.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A [closure](#closure) that runs its payload on an executor instead
+ * of the thread that calls the C function.
+ *
+ * If @a F returns `void`, each call copies its arguments into a task, submits
+ * it and returns immediately. Otherwise the caller blocks until the payload
+ * has run on the executor and receives its result; callers that are threads
+ * of the executor run the payload inline to avoid deadlocks.
+ *
+ * An exception thrown by the payload, or by the executor while submitting a
+ * call, terminates the program rather than unwinding into the C caller.
+ *
+ * Construct with `dispatched_closure<F, P, E>{executor, payload-args...}`.
+ * The executor must outlive the closure. The destructor waits for submitted
+ * calls to finish.
+ *
+ * @tparam F The desired call signature of the trampoline; either a function
+ * type or a pointer to function type.
+ *
+ * @tparam P A user-provided callable payload that should be invoked on the
+ * executor.
+ *
+ * @tparam E The executor; anything with `submit(fun)` that eventually invokes
+ * `fun()` once.
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename P, typename E = work_stealing_pool>
+using dispatched_closure =
+    detail::closure_impl<detail::call_signature<F>,
+                         detail::dispatcher<detail::call_signature<F>, P, E>,
+                         detail::ffi::closure,
+                         detail::default_call_hooks<
+                             detail::call_signature<F>,
+                             detail::dispatcher<detail::call_signature<F>, P,
+                                                E>>>;
+
+/**
+ * @brief Constructs a new [dispatched_closure](#dispatched_closure) deducing
+ * the payload and executor types automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename E, typename P>
+auto make_dispatched_closure(E &executor, P payload)
+    -> dispatched_closure<F, P, E> {
+  return dispatched_closure<F, P, E>{executor, std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,38 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_EXECUTABLE_MEMORY_H
+#define VOIDSTAR_EXECUTABLE_MEMORY_H
+
+#include <voidstar/detail/native/executable_memory.h>
+
+namespace voidstar {
+
+/**
+ * @brief Usage of the executable memory that voidstar maps for trampolines
+ * itself, as opposed to trampolines allocated by libffi.
+ *
+ * @since 1.0.0
+ */
+using executable_memory_stats = detail::native::executable_memory_stats;
+
+/**
+ * @brief Snapshot the usage of executable memory mapped by voidstar.
+ *
+ * All fields are zero on platforms where voidstar does not map executable
+ * memory itself.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto collect_executable_memory_stats() noexcept
+    -> executable_memory_stats {
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+  return detail::native::global_memory_counters.snapshot();
+#else
+  return {};
+#endif
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,34 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_INVOKER_H
+#define VOIDSTAR_INVOKER_H
+
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/invoker.h>
+
+namespace voidstar {
+
+/**
+ * @brief Calls C function pointers of type @a F through libffi.
+ *
+ * The `ffi_cif` for @a F is prepared once per process and shared with closures
+ * of the same signature. Each call packs its arguments on the stack and does
+ * not allocate.
+ *
+ * ```c++
+ * voidstar::invoker<int(int, float)> const invoke;
+ * int result = invoke(some_fn_ptr, 42, 1.5f);
+ * ```
+ *
+ * @tparam F The call signature of the called functions; either a function type
+ * or a pointer to function type.
+ *
+ * @since 1.0.0
+ */
+template <typename F>
+using invoker = detail::ffi::invoker<detail::call_signature<F>>;
+
+} // namespace voidstar
+
+#endif
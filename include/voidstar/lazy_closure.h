@@ -0,0 +1,49 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_LAZY_CLOSURE_H
+#define VOIDSTAR_LAZY_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/ffi/closure.h>
+#include <voidstar/detail/ffi/lazy_trampoline.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A [closure](#closure) whose trampoline is allocated and prepared on
+ * the first request for its function pointer.
+ *
+ * The payload is constructed immediately. The first call to `get()` or
+ * `operator fn_ptr_type()` prepares the trampoline and may throw
+ * `voidstar::error`; subsequent calls only perform an atomic load. Concurrent
+ * first calls are safe and observe the same function pointer.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using lazy_closure = detail::closure_impl<
+    detail::call_signature<F>, P,
+    detail::ffi::lazy_trampoline<detail::ffi::closure>,
+    detail::default_call_hooks<detail::call_signature<F>, P>>;
+
+/**
+ * @brief Constructs a new [lazy_closure](#lazy_closure) deducing the payload
+ * type automatically, useful for lambdas.
+ *
+ * @param payload The object to invoke through the C function pointer. It is
+ * moved into the closure.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_lazy_closure(P payload) -> lazy_closure<F, P> {
+  return lazy_closure<F, P>{std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,106 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_METRICS_H
+#define VOIDSTAR_METRICS_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/metrics.h>
+
+#include <concepts>
+#include <map>
+#include <span>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+namespace voidstar {
+
+/**
+ * @brief Call counts, concurrency and latency of one or more closures.
+ *
+ * @since 1.0.0
+ */
+using call_metrics = detail::metrics::call_metrics;
+
+/**
+ * @brief Metrics of all instrumented closures with the same signature and
+ * payload type.
+ *
+ * @since 1.0.0
+ */
+using closure_metrics_record = detail::metrics::metrics_record;
+
+/**
+ * @brief A [closure](#closure) that records `call_metrics` of its payload
+ * invocations.
+ *
+ * Equivalent to `closure<F, P>` when `VOIDSTAR_CLOSURE_METRICS` is defined.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using instrumented_closure = detail::closure_impl<
+    detail::call_signature<F>, P, detail::ffi::closure,
+    detail::metrics::recording_hooks<detail::call_signature<F>, P>>;
+
+/**
+ * @brief Constructs a new [instrumented_closure](#instrumented_closure)
+ * deducing the payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_instrumented_closure(P payload) -> instrumented_closure<F, P> {
+  return instrumented_closure<F, P>{std::move(payload)};
+}
+
+/**
+ * @brief Snapshot the metrics of a single instrumented closure.
+ *
+ * @since 1.0.0
+ */
+template <typename C>
+requires requires(C const &cls) {
+  { cls.hooks().snapshot() } -> std::same_as<call_metrics>;
+}
+[[nodiscard]] auto closure_metrics(C const &cls) noexcept -> call_metrics {
+  return cls.hooks().snapshot();
+}
+
+/**
+ * @brief Snapshot the metrics of all instrumented closures, including
+ * destroyed ones, grouped by signature and payload type.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto collect_closure_metrics()
+    -> std::vector<closure_metrics_record> {
+  return detail::metrics::registry::instance().collect();
+}
+
+/**
+ * @brief Combine @a records that have the same @a key, such as
+ * `&closure_metrics_record::signature`.
+ *
+ * @since 1.0.0
+ */
+[[nodiscard]] inline auto
+aggregate_closure_metrics(std::span<closure_metrics_record const> records,
+                          std::type_index closure_metrics_record::*key)
+    -> std::map<std::type_index, call_metrics> {
+  std::map<std::type_index, call_metrics> result;
+  for (auto const &record : records) {
+    auto const [it, inserted] =
+        result.try_emplace(record.*key, record.metrics);
+    if (not inserted) {
+      it->second += record.metrics;
+    }
+  }
+  return result;
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,72 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_QUEUED_CLOSURE_H
+#define VOIDSTAR_QUEUED_CLOSURE_H
+
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/native/direct.h>
+#include <voidstar/detail/queued_closure.h>
+
+namespace voidstar {
+
+/**
+ * @brief What a [queued_closure](#queued_closure) does when its queue is
+ * full: `drop` the call, or `block` the calling thread until there is room.
+ *
+ * @since 1.0.0
+ */
+using overflow_policy = detail::overflow_policy;
+
+/**
+ * @brief Construction parameters of a [queued_closure](#queued_closure) with
+ * call signature @a F.
+ *
+ * Fields: `capacity`, `on_overflow`, `eventfd` and, unless @a F returns
+ * `void`, the `accepted_result` and `rejected_result` returned to the C
+ * caller.
+ *
+ * @since 1.0.0
+ */
+template <typename F>
+using queued_closure_options = detail::queued_closure_options<
+    typename detail::call_signature<F>::return_type>;
+
+/**
+ * @brief Counters of a [queued_closure](#queued_closure): current `depth`,
+ * `capacity`, and the number of calls `drained`, `dropped` and `blocked`.
+ *
+ * @since 1.0.0
+ */
+using queue_stats = detail::queue_stats;
+
+/**
+ * @brief A C function pointer that copies its arguments into a bounded
+ * lock-free queue and returns immediately.
+ *
+ * Any thread may invoke the callback; one consumer thread at a time calls
+ * `drain(handler, max_batch)` to process queued calls in order. The consumer
+ * may sleep in `wait()` or, when constructed with `.eventfd = true`, poll
+ * `event_fd()` in an event loop. Arguments are copied by value, so pointers
+ * must stay valid until they are drained.
+ *
+ * The trampoline is a direct trampoline where the call signature allows it,
+ * as in [direct_closure](#direct_closure).
+ *
+ * With `overflow_policy::block`, a C caller on the consumer thread will wait
+ * forever once the queue is full.
+ *
+ * @tparam F The call signature of the callback; either a function type or a
+ * pointer to function type.
+ *
+ * @since 1.0.0
+ */
+template <typename F>
+using queued_closure =
+    detail::queued_closure_impl<detail::call_signature<F>,
+                                detail::native::direct_or_ffi_trampoline<
+                                    detail::call_signature<F>>>;
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,61 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_REBINDABLE_CLOSURE_H
+#define VOIDSTAR_REBINDABLE_CLOSURE_H
+
+#include <voidstar/any_closure.h>
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/native/direct.h>
+#include <voidstar/detail/rebindable.h>
+#include <voidstar/detail/reclaim.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A closure with a fixed C function pointer whose target can be
+ * replaced atomically while calls are in flight.
+ *
+ * The target is heap-allocated. Each call increments a sharded in-flight
+ * counter (sequentially consistent), reads the target with an acquire load
+ * and increments an exit counter (release) when it returns.
+ * `payload().rebind(args...)` publishes a new target constructed from
+ * `args`; the old one is destroyed on the reclaimer thread of
+ * [retirable_closure](#retirable_closure) once calls that may still use it
+ * have exited. Calls are counted as in flight in the same way as for
+ * [retirable_closure](#retirable_closure).
+ *
+ * @tparam F The desired call signature of the trampoline; either a function
+ * type or a pointer to function type.
+ *
+ * @tparam P The type of targets; by default any copyable callable matching
+ * @a F.
+ *
+ * @since 1.0.0
+ */
+template <typename F,
+          detail::matches<detail::call_signature<F>> P = any_payload<F>>
+using rebindable_closure = detail::closure_impl<
+    detail::call_signature<F>,
+    detail::rebindable<detail::call_signature<F>, P>,
+    detail::native::direct_or_ffi_trampoline<detail::call_signature<F>>,
+    detail::reclaim::in_flight_tracking>;
+
+/**
+ * @brief Constructs a new [rebindable_closure](#rebindable_closure) whose
+ * targets may be any copyable callable matching @a F, starting with
+ * @a target.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> T>
+auto make_rebindable_closure(T target) -> rebindable_closure<F> {
+  return rebindable_closure<F>{std::move(target)};
+}
+
+} // namespace voidstar
+
+#endif
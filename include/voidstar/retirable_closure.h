@@ -0,0 +1,113 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_RETIRABLE_CLOSURE_H
+#define VOIDSTAR_RETIRABLE_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/closure_handle.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/reclaim.h>
+
+#include <concepts>
+#include <memory>
+#include <utility>
+
+namespace voidstar {
+
+namespace detail {
+
+/**
+ * @brief A movable owning handle to a heap-allocated closure @a C that is
+ * destroyed by the reclaimer once calls in flight have exited.
+ *
+ * @a C must track its calls in `reclaim::domain::global()` from its entry
+ * point on, e.g. with `reclaim::in_flight_tracking`. The trampoline is a
+ * member of @a C, so it is kept until the same grace period has passed.
+ */
+template <typename C>
+class retirable_handle : public closure_handle_base<retirable_handle<C>, C> {
+private:
+  friend closure_handle_base<retirable_handle<C>, C>;
+
+  std::unique_ptr<C, reclaim::deferred_delete<C>> m_closure;
+
+  [[nodiscard]] auto closure_ptr() const noexcept -> C * {
+    return m_closure.get();
+  }
+
+public:
+  /**
+   * @brief Allocate a closure, forwarding @a args to its constructor.
+   *
+   * Starts the reclaimer thread if it is not running yet.
+   *
+   * @throws Any exception thrown by the closure constructor or by `new`.
+   * @throws std::system_error if the reclaimer thread could not be started.
+   */
+  template <typename... A>
+  requires std::constructible_from<C, A...>
+  explicit retirable_handle(A &&...args)
+      : m_closure{((void)reclaim::reclaimer::instance(),
+                   new C(std::forward<A>(args)...))} {}
+
+  retirable_handle(retirable_handle &&) noexcept = default;
+  auto operator=(retirable_handle &&) noexcept -> retirable_handle & = default;
+
+  /// @brief Retires the managed closure, if any.
+  ~retirable_handle() = default;
+
+  /**
+   * @brief Hand the managed closure over to the reclaimer, leaving the handle
+   * empty. Does not block.
+   */
+  void retire() noexcept { m_closure.reset(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief A movable owning handle to a heap-allocated [closure](#closure) that
+ * may be released while it is being called.
+ *
+ * Each call of the C function is counted as in flight from the moment libffi
+ * enters voidstar's code, before the closure is read, until it returns.
+ * `retire()` and the destructor return immediately; the closure and its
+ * trampoline are destroyed on a background thread once all calls that were in
+ * flight at the time have returned. No new calls may start after the closure
+ * is retired.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+using retirable_closure = detail::retirable_handle<
+    detail::closure_impl<detail::call_signature<F>, P, detail::ffi::closure,
+                         detail::reclaim::in_flight_tracking>>;
+
+/**
+ * @brief Constructs a new [retirable_closure](#retirable_closure) deducing the
+ * payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+auto make_retirable_closure(P payload) -> retirable_closure<F, P> {
+  return retirable_closure<F, P>{std::move(payload)};
+}
+
+/**
+ * @brief Block until every [retirable_closure](#retirable_closure) retired
+ * before this call has been destroyed.
+ *
+ * Must not be called from a payload of a retirable closure or from a payload
+ * destructor.
+ *
+ * @since 1.0.0
+ */
+inline void wait_for_retired_closures() {
+  detail::reclaim::reclaimer::instance().barrier();
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,96 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_STATIC_CLOSURE_H
+#define VOIDSTAR_STATIC_CLOSURE_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/static_closure.h>
+
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A C function pointer to a statically compiled function that invokes
+ * the compile-time constant @a Callable.
+ *
+ * No memory is allocated and libffi is not involved. If @a Callable converts
+ * to the function pointer type itself, like a function pointer or a
+ * captureless lambda of exactly signature @a F, that pointer is used as is.
+ *
+ * @tparam Callable A constant callable, such as a function pointer or a
+ * captureless lambda.
+ *
+ * @tparam F The desired call signature; either a function type or a pointer
+ * to function type. Deduced from @a Callable if it is a function pointer or
+ * has a single non-template `const` call operator.
+ *
+ * @since 1.0.0
+ */
+template <auto Callable,
+          typename F =
+              typename detail::callable_signature<decltype(Callable)>::type>
+requires detail::matches<decltype(Callable), detail::call_signature<F>>
+class static_closure {
+private:
+  using function = detail::constant_function<Callable,
+                                             detail::call_signature<F>>;
+
+public:
+  /// @brief Type of the function pointer.
+  using fn_ptr_type = typename detail::call_signature<F>::fn_ptr_type;
+
+  /// @brief The function pointer.
+  static constexpr fn_ptr_type value = function::value;
+
+  /// @brief Obtain the function pointer.
+  [[nodiscard]] static constexpr auto get() noexcept -> fn_ptr_type {
+    return value;
+  }
+
+  /// @brief Obtain the function pointer.
+  constexpr operator fn_ptr_type() const noexcept { return value; }
+};
+
+/**
+ * @brief A [closure](#closure) of a stateless payload that shares one
+ * statically compiled function instead of generating a trampoline.
+ *
+ * Construction allocates nothing and involves no libffi calls. The function
+ * invokes a default-constructed @a P, so all stateless closures with the same
+ * @a F and @a P have the same function pointer, which remains valid after the
+ * closure is destroyed. Such closures cannot be told apart by address, so
+ * they cannot be [registered](#registered), and call hooks such as
+ * `VOIDSTAR_CLOSURE_METRICS` do not apply to them.
+ *
+ * @tparam F The desired call signature; either a function type or a pointer
+ * to function type.
+ *
+ * @tparam P An empty, trivially default-constructible and trivially
+ * destructible payload, such as a captureless lambda.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+requires detail::stateless_payload<P>
+using stateless_closure =
+    detail::closure_impl<detail::call_signature<F>, P,
+                         detail::static_trampoline, detail::no_call_hooks>;
+
+/**
+ * @brief Constructs a new [stateless_closure](#stateless_closure) deducing
+ * the payload type automatically, useful for lambdas.
+ *
+ * @since 1.0.0
+ */
+template <typename F, detail::matches<detail::call_signature<F>> P>
+requires detail::stateless_payload<P>
+auto make_stateless_closure(P payload) -> stateless_closure<F, P> {
+  return stateless_closure<F, P>{std::move(payload)};
+}
+
+} // namespace voidstar
+
+#endif
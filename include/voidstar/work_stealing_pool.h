@@ -0,0 +1,26 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_WORK_STEALING_POOL_H
+#define VOIDSTAR_WORK_STEALING_POOL_H
+
+#include <voidstar/detail/work_stealing_pool.h>
+
+namespace voidstar {
+
+/**
+ * @brief A thread pool with one task deque per worker, where idle workers
+ * steal from busy ones.
+ *
+ * `submit(fun)` queues a nullary callable; `running_in_this_thread()` tells
+ * whether the caller is a worker. The destructor runs all queued tasks and
+ * joins the workers. It is the default executor of
+ * [dispatched_closure](#dispatched_closure).
+ *
+ * @since 1.0.0
+ */
+using work_stealing_pool = detail::work_stealing_pool;
+
+} // namespace voidstar
+
+#endif
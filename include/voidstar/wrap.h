@@ -0,0 +1,103 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#ifndef VOIDSTAR_WRAP_H
+#define VOIDSTAR_WRAP_H
+
+#include <voidstar/closure.h>
+#include <voidstar/detail/call_signature.h>
+#include <voidstar/detail/native/direct.h>
+#include <voidstar/detail/wrap.h>
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace voidstar {
+
+/**
+ * @brief A closure with call signature @a F that calls an existing function
+ * pointer of the same type through decorator @a D.
+ *
+ * @a D either is invocable with the original function pointer followed by the
+ * arguments, or has optional `before(args...)` and `after(result, args...)`
+ * members (`after(args...)` if @a F returns `void`). The trampoline avoids
+ * libffi where the call signature allows it, so with hooks that inline away
+ * the wrapper costs about as much as a direct closure.
+ *
+ * Construct with `decorated_closure<F, D>{original, decorator-args...}` or
+ * with [wrap](#wrap).
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename D>
+using decorated_closure = detail::closure_impl<
+    detail::call_signature<F>, detail::decorated<detail::call_signature<F>, D>,
+    detail::native::direct_or_ffi_trampoline<detail::call_signature<F>>,
+    detail::default_call_hooks<
+        detail::call_signature<F>,
+        detail::decorated<detail::call_signature<F>, D>>>;
+
+/**
+ * @brief Wraps @a original into a
+ * [decorated_closure](#decorated_closure) that runs @a decorator around each
+ * call.
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename D>
+auto wrap(typename detail::call_signature<F>::fn_ptr_type original,
+          D decorator) -> decorated_closure<F, D> {
+  return decorated_closure<F, D>{original, std::move(decorator)};
+}
+
+/**
+ * @brief Wraps @a original into a
+ * [decorated_closure](#decorated_closure), deducing the call signature.
+ *
+ * @since 1.0.0
+ */
+template <typename R, typename... A, typename D>
+auto wrap(R (*original)(A...), D decorator) -> decorated_closure<R(A...), D> {
+  return decorated_closure<R(A...), D>{original, std::move(decorator)};
+}
+
+/**
+ * @brief A closure with call signature @a F that calls function @a G with
+ * bound leading arguments @a B followed by its own arguments.
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename G, typename... B>
+using bound_closure = detail::closure_impl<
+    detail::call_signature<F>,
+    detail::front_bound<detail::call_signature<F>, G, std::tuple<B...>>,
+    detail::native::direct_or_ffi_trampoline<detail::call_signature<F>>,
+    detail::default_call_hooks<
+        detail::call_signature<F>,
+        detail::front_bound<detail::call_signature<F>, G, std::tuple<B...>>>>;
+
+/**
+ * @brief Creates a C function pointer of type @a F that calls @a original
+ * with copies of @a bound in front of its own arguments.
+ *
+ * This adapts a function that expects context in its leading parameters to
+ * an API that does not pass any:
+ *
+ * ```c++
+ * int on_event(session *s, int code);
+ * auto adapted = voidstar::bind_front<int(int)>(&on_event, my_session);
+ * register_handler(adapted.get());
+ * ```
+ *
+ * @since 1.0.0
+ */
+template <typename F, typename G, typename... B>
+requires std::is_function_v<G>
+auto bind_front(G *original, B... bound) -> bound_closure<F, G, B...> {
+  return bound_closure<F, G, B...>{original, std::move(bound)...};
+}
+
+} // namespace voidstar
+
+#endif
@@ -0,0 +1,149 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+// Experimental module interface of voidstar. Exports the public voidstar
+// namespace only; voidstar::detail stays reachable for instantiation but cannot
+// be named by importers.
+
+module;
+
+#include <voidstar.h>
+#include <voidstar/any_closure.h>
+#include <voidstar/awaitable_callback.h>
+#include <voidstar/banked_closure.h>
+#include <voidstar/closure_arena.h>
+#include <voidstar/closure_array.h>
+#include <voidstar/closure_pool.h>
+#include <voidstar/closure_registry.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/dispatched_closure.h>
+#include <voidstar/executable_memory.h>
+#include <voidstar/invoker.h>
+#include <voidstar/lazy_closure.h>
+#include <voidstar/metrics.h>
+#include <voidstar/queued_closure.h>
+#include <voidstar/rebindable_closure.h>
+#include <voidstar/retirable_closure.h>
+#include <voidstar/static_closure.h>
+#include <voidstar/work_stealing_pool.h>
+#include <voidstar/wrap.h>
+
+export module voidstar;
+
+export namespace voidstar {
+
+// closure.h
+using voidstar::closure;
+using voidstar::make_closure;
+using voidstar::trim_closure_cache;
+
+// any_closure.h
+using voidstar::any_closure;
+using voidstar::any_payload;
+using voidstar::default_any_buffer_size;
+
+// awaitable_callback.h
+using voidstar::awaitable_callback;
+using voidstar::pooled_awaitable_callback;
+using voidstar::resume_inline;
+
+// banked_closure.h
+using voidstar::bank_exhausted_error;
+using voidstar::banked_closure;
+using voidstar::banked_closures_in_use;
+using voidstar::default_bank_capacity;
+using voidstar::make_banked_closure;
+
+// closure_arena.h
+using voidstar::arena_closure;
+using voidstar::closure_arena;
+using voidstar::closure_arena_options;
+
+// closure_array.h
+using voidstar::closure_array;
+using voidstar::make_closures;
+
+// closure_handle.h
+using voidstar::make_shared_closure;
+using voidstar::make_unique_closure;
+using voidstar::shared_closure;
+using voidstar::unique_closure;
+
+// closure_pool.h
+using voidstar::closure_pool;
+using voidstar::closure_pool_options;
+using voidstar::pooled_closure;
+
+// closure_registry.h
+using voidstar::closure_info;
+using voidstar::find_closure;
+using voidstar::is_live;
+using voidstar::make_registered_closure;
+using voidstar::registered;
+using voidstar::registered_closure;
+using voidstar::registered_closure_count;
+
+// direct_closure.h
+using voidstar::direct_closure;
+using voidstar::make_direct_closure;
+
+// dispatched_closure.h
+using voidstar::dispatched_closure;
+using voidstar::make_dispatched_closure;
+
+// error.h
+using voidstar::error;
+
+// executable_memory.h
+using voidstar::collect_executable_memory_stats;
+using voidstar::executable_memory_stats;
+
+// invoker.h
+using voidstar::invoker;
+
+// layout.h
+using voidstar::layout;
+
+// lazy_closure.h
+using voidstar::lazy_closure;
+using voidstar::make_lazy_closure;
+
+// metrics.h
+using voidstar::aggregate_closure_metrics;
+using voidstar::call_metrics;
+using voidstar::closure_metrics;
+using voidstar::closure_metrics_record;
+using voidstar::collect_closure_metrics;
+using voidstar::instrumented_closure;
+using voidstar::make_instrumented_closure;
+
+// queued_closure.h
+using voidstar::overflow_policy;
+using voidstar::queue_stats;
+using voidstar::queued_closure;
+using voidstar::queued_closure_options;
+
+// rebindable_closure.h
+using voidstar::make_rebindable_closure;
+using voidstar::rebindable_closure;
+
+// retirable_closure.h
+using voidstar::make_retirable_closure;
+using voidstar::retirable_closure;
+using voidstar::wait_for_retired_closures;
+
+// static_closure.h
+using voidstar::make_stateless_closure;
+using voidstar::static_closure;
+using voidstar::stateless_closure;
+
+// work_stealing_pool.h
+using voidstar::work_stealing_pool;
+
+// wrap.h
+using voidstar::bind_front;
+using voidstar::bound_closure;
+using voidstar::decorated_closure;
+using voidstar::wrap;
+
+} // namespace voidstar
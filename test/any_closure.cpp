@@ -0,0 +1,174 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/any_closure.h>
+#include <voidstar/closure_array.h>
+
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(AnyClosure, DifferentCallablesShareType) {
+  std::deque<any_closure<int(int)>> closures;
+  closures.emplace_back([](int x) { return x + 1; });
+  closures.emplace_back([k = 3](int x) { return x * k; });
+  closures.emplace_back(std::negate<>{});
+  closures.emplace_back(+[](int x) { return x - 1; });
+
+  std::vector<int> results;
+  for (auto const &cls : closures) {
+    results.push_back(cls.get()(10));
+  }
+  EXPECT_EQ(results, (std::vector<int>{11, 30, -10, 9}));
+}
+
+TEST(AnyClosure, SmallPayloadsStoredInline) {
+  int calls = 0;
+  any_closure<void()> cls{[&calls] { calls++; }};
+  EXPECT_FALSE(cls.payload().is_heap_allocated());
+
+  cls.get()();
+  cls.get()();
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(AnyClosure, LargePayloadsOnHeap) {
+  std::array<long, 16> table{};
+  table[5] = 42;
+
+  any_closure<long(int)> cls{[table](int i) { return table[i]; }};
+  EXPECT_TRUE(cls.payload().is_heap_allocated());
+  EXPECT_EQ(cls.get()(5), 42);
+}
+
+TEST(AnyClosure, CustomBufferSize) {
+  std::array<long, 16> table{};
+  table[1] = 7;
+
+  auto lookup = [table](int i) { return table[i]; };
+  static_assert(not any_payload<long(int)>::is_stored_inline<decltype(lookup)>);
+  static_assert(any_payload<long(int), 256>::is_stored_inline<decltype(lookup)>);
+
+  any_closure<long(int), 256> cls{lookup};
+  EXPECT_FALSE(cls.payload().is_heap_allocated());
+  EXPECT_EQ(cls.get()(1), 7);
+}
+
+TEST(AnyClosure, MutablePayload) {
+  any_closure<int()> cls{[n = 0]() mutable { return ++n; }};
+  auto fn = cls.get();
+  EXPECT_EQ(fn(), 1);
+  EXPECT_EQ(fn(), 2);
+  EXPECT_EQ(fn(), 3);
+}
+
+TEST(AnyClosure, Target) {
+  struct counter {
+    int value;
+    auto operator()() const -> int { return value; }
+  };
+
+  any_closure<int()> cls{counter{5}};
+  ASSERT_NE(cls.payload().target<counter>(), nullptr);
+  EXPECT_EQ(cls.payload().target<counter>()->value, 5);
+  EXPECT_EQ(cls.payload().target<int (*)()>(), nullptr);
+
+  cls.payload().target<counter>()->value = 6;
+  EXPECT_EQ(cls.get()(), 6);
+}
+
+TEST(AnyClosure, PayloadLifetime) {
+  auto token = std::make_shared<int>(0);
+
+  struct small {
+    std::shared_ptr<int> token;
+    void operator()() const {}
+  };
+  struct large {
+    std::shared_ptr<int> token;
+    char padding[256] = {};
+    void operator()() const {}
+  };
+
+  {
+    any_closure<void()> a{small{token}};
+    any_closure<void()> b{large{token}};
+    EXPECT_EQ(token.use_count(), 3);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(AnyPayload, CopyAndMove) {
+  auto token = std::make_shared<int>(0);
+  {
+    any_payload<int()> a{[token] { return *token; }};
+    any_payload<int()> b{
+        [token, padding = std::array<char, 256>{}] { return *token; }};
+    EXPECT_EQ(token.use_count(), 3);
+
+    any_payload<int()> a_copy{a};
+    any_payload<int()> b_copy{b};
+    EXPECT_EQ(token.use_count(), 5);
+
+    any_payload<int()> a_moved{std::move(a)};
+    any_payload<int()> b_moved{std::move(b)};
+    EXPECT_EQ(token.use_count(), 5);
+
+    *token = 9;
+    EXPECT_EQ(a_copy(), 9);
+    EXPECT_EQ(b_copy(), 9);
+    EXPECT_EQ(a_moved(), 9);
+    EXPECT_EQ(b_moved(), 9);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(AnyPayload, InPlace) {
+  struct greeting {
+    std::string text;
+    greeting(std::string prefix, std::string name)
+        : text{std::move(prefix) + name} {}
+    auto operator()() const -> std::size_t { return text.size(); }
+  };
+
+  any_closure<std::size_t()> cls{std::in_place_type<greeting>, "Hello, ",
+                                 "world"};
+  EXPECT_EQ(cls.get()(), 12);
+}
+
+TEST(AnyPayload, ClosureArray) {
+  std::vector<any_payload<int(int)>> payloads;
+  payloads.emplace_back([](int x) { return x + 1; });
+  payloads.emplace_back([](int x) { return x * 2; });
+  payloads.emplace_back(std::negate<>{});
+
+  closure_array<int(int), any_payload<int(int)>> closures{payloads};
+  EXPECT_EQ(closures.get(0)(5), 6);
+  EXPECT_EQ(closures.get(1)(5), 10);
+  EXPECT_EQ(closures.get(2)(5), -5);
+}
+
+TEST(AnyClosure, MixedArguments) {
+  int counter = 0;
+  any_closure<double(double, int *, float)> cls{
+      [](double a, int *count, float b) {
+        (*count)++;
+        return a * b;
+      }};
+  EXPECT_EQ(cls.get()(2.0, &counter, 1.5F), 3.0);
+  EXPECT_EQ(counter, 1);
+}
+
+} // namespace
+} // namespace voidstar::test
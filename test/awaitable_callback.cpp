@@ -0,0 +1,204 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/awaitable_callback.h>
+#include <voidstar/closure_pool.h>
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+/// @brief A coroutine that starts eagerly and is destroyed when it finishes.
+struct eager_task {
+  struct promise_type {
+    auto get_return_object() noexcept -> eager_task { return {}; }
+    auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+    auto final_suspend() noexcept -> std::suspend_never { return {}; }
+    void return_void() noexcept {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+/// @brief An executor that queues resumptions until drained.
+struct queue_executor {
+  std::deque<std::coroutine_handle<>> *queue;
+
+  void operator()(std::coroutine_handle<> handle) const {
+    queue->push_back(handle);
+  }
+};
+
+/// @brief Await @a callback once and store the result in @a received.
+template <typename C, typename R>
+auto await_into(C &callback, R &received) -> eager_task {
+  received = co_await callback;
+}
+
+TEST(AwaitableCallback, ResumesWithArgument) {
+  awaitable_callback<void(double)> callback;
+  double received = 0;
+
+  await_into(callback, received);
+  EXPECT_EQ(received, 0);
+
+  callback.get()(2.5);
+  EXPECT_EQ(received, 2.5);
+}
+
+TEST(AwaitableCallback, CompletedBeforeAwait) {
+  awaitable_callback<void(int)> callback;
+  callback.get()(7);
+  EXPECT_TRUE(callback.is_completed());
+
+  int received = 0;
+  await_into(callback, received);
+  EXPECT_EQ(received, 7);
+  EXPECT_FALSE(callback.is_completed());
+}
+
+auto await_both(awaitable_callback<void()> &none,
+                awaitable_callback<void(int, char const *)> &several,
+                std::tuple<int, char const *> &received, bool &done)
+    -> eager_task {
+  co_await none;
+  received = co_await several;
+  done = true;
+}
+
+TEST(AwaitableCallback, ArgumentShapes) {
+  awaitable_callback<void()> none;
+  awaitable_callback<void(int, char const *)> several;
+
+  std::tuple<int, char const *> received;
+  bool done = false;
+  await_both(none, several, received, done);
+
+  none.get()();
+  EXPECT_FALSE(done);
+  several.get()(3, "three");
+  EXPECT_TRUE(done);
+  EXPECT_EQ(std::get<0>(received), 3);
+  EXPECT_STREQ(std::get<1>(received), "three");
+}
+
+TEST(AwaitableCallback, NonVoidCallback) {
+  awaitable_callback<int(int)> callback;
+  int received = 0;
+
+  await_into(callback, received);
+  EXPECT_EQ(callback.get()(5), 0);
+  EXPECT_EQ(received, 5);
+}
+
+auto await_repeatedly(awaitable_callback<void(int)> &callback, int count,
+                      std::vector<int> &received) -> eager_task {
+  for (int i = 0; i < count; i++) {
+    received.push_back(co_await callback);
+  }
+}
+
+TEST(AwaitableCallback, ReusedAcrossAwaits) {
+  awaitable_callback<void(int)> callback;
+  void (*const ptr)(int) = callback;
+
+  std::vector<int> received;
+  await_repeatedly(callback, 3, received);
+
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(callback.get(), ptr);
+    ptr(i * 10);
+  }
+  EXPECT_EQ(received, (std::vector<int>{0, 10, 20}));
+}
+
+TEST(AwaitableCallback, ExecutorHop) {
+  std::deque<std::coroutine_handle<>> queue;
+  awaitable_callback<void(int), queue_executor> callback{
+      queue_executor{&queue}};
+  int received = 0;
+
+  await_into(callback, received);
+  callback.get()(9);
+  EXPECT_EQ(received, 0);
+  ASSERT_EQ(queue.size(), 1);
+
+  queue.front().resume();
+  EXPECT_EQ(received, 9);
+}
+
+auto await_and_record_thread(awaitable_callback<void(int)> &callback,
+                             int &received, std::thread::id &resumed_on)
+    -> eager_task {
+  received = co_await callback;
+  resumed_on = std::this_thread::get_id();
+}
+
+TEST(AwaitableCallback, ResumesOnCallingThread) {
+  awaitable_callback<void(int)> callback;
+  int received = 0;
+  std::thread::id resumed_on;
+
+  await_and_record_thread(callback, received, resumed_on);
+
+  std::thread::id caller;
+  std::jthread{[&] {
+    caller = std::this_thread::get_id();
+    callback.get()(4);
+  }}.join();
+
+  EXPECT_EQ(received, 4);
+  EXPECT_EQ(resumed_on, caller);
+}
+
+/// @brief Await a callback that lives in the coroutine frame, so the frame and
+/// the callback are destroyed while the callback is still running.
+template <typename F>
+auto own_and_await(typename awaitable_callback<F>::fn_ptr_type &published,
+                   int &received) -> eager_task {
+  awaitable_callback<F> callback;
+  published = callback.get();
+  received = co_await callback;
+}
+
+TEST(AwaitableCallback, FrameEndsDuringCallback) {
+  void (*callback)(int) = nullptr;
+  int received = 0;
+
+  own_and_await<void(int)>(callback, received);
+  callback(3);
+  EXPECT_EQ(received, 3);
+}
+
+TEST(AwaitableCallback, FrameEndsDuringNonVoidCallback) {
+  long (*callback)(int) = nullptr;
+  int received = 0;
+
+  own_and_await<long(int)>(callback, received);
+  EXPECT_EQ(callback(8), 0);
+  EXPECT_EQ(received, 8);
+}
+
+TEST(AwaitableCallback, Pooled) {
+  closure_pool<void(long)> pool{
+      {.low_watermark = 1, .high_watermark = 2, .background_refill = false}};
+  long received = 0;
+
+  {
+    pooled_awaitable_callback<void(long)> callback{pool};
+    await_into(callback, received);
+    callback.get()(11);
+  }
+  EXPECT_EQ(received, 11);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,138 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/banked_closure.h>
+
+#include <atomic>
+#include <latch>
+#include <list>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(BankedClosure, SimpleCall) {
+  int calls = 0;
+
+  auto cls = make_banked_closure<int(int)>([&](int x) {
+    calls++;
+    return x * 2;
+  });
+
+  EXPECT_EQ(cls.get()(21), 42);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(BankedClosure, AnySignature) {
+  struct big {
+    long a, b, c, d;
+  };
+
+  auto cls = make_banked_closure<big(big, long double, float)>(
+      [](big x, long double y, float z) {
+        return big{x.d, x.c, x.b, x.a + static_cast<long>(y + z)};
+      });
+
+  auto const result = cls.get()(big{1, 2, 3, 4}, 10.0L, 0.5f);
+  EXPECT_EQ(result.a, 4);
+  EXPECT_EQ(result.b, 3);
+  EXPECT_EQ(result.c, 2);
+  EXPECT_EQ(result.d, 11);
+}
+
+TEST(BankedClosure, DistinctEntryPoints) {
+  constexpr std::size_t capacity = 100;
+  using signature = int();
+
+  auto make_payload = [](int i) { return [i] { return i; }; };
+  using cls_t = banked_closure<signature, decltype(make_payload(0)), capacity>;
+
+  std::list<cls_t> clses;
+  std::set<int (*)()> pointers;
+  for (std::size_t i = 0; i < capacity; i++) {
+    pointers.insert(clses.emplace_back(make_payload(static_cast<int>(i))).get());
+  }
+  EXPECT_EQ(pointers.size(), capacity);
+  EXPECT_EQ((banked_closures_in_use<signature, capacity>()), capacity);
+
+  int i = 0;
+  for (auto const &cls : clses) {
+    EXPECT_EQ(cls.get()(), i++);
+  }
+
+  clses.clear();
+  EXPECT_EQ((banked_closures_in_use<signature, capacity>()), 0);
+}
+
+TEST(BankedClosure, Exhaustion) {
+  constexpr std::size_t capacity = 3;
+
+  struct payload {
+    int *constructed;
+    explicit payload(int *constructed) : constructed{constructed} {
+      (*constructed)++;
+    }
+    void operator()() const {}
+  };
+  using cls_t = banked_closure<void(), payload, capacity>;
+
+  int constructed = 0;
+  std::list<cls_t> clses;
+  for (std::size_t i = 0; i < capacity; i++) {
+    clses.emplace_back(&constructed);
+  }
+
+  EXPECT_THROW(cls_t{&constructed}, bank_exhausted_error);
+  EXPECT_EQ(constructed, capacity);
+
+  // A released slot is available again
+  auto *const released = clses.front().get();
+  clses.pop_front();
+  EXPECT_EQ(clses.emplace_back(&constructed).get(), released);
+}
+
+TEST(BankedClosure, ConcurrentAcquire) {
+  constexpr std::size_t capacity = 256;
+  constexpr int thread_count = 8;
+  constexpr int per_thread = 32;
+  using signature = int(int);
+
+  std::mutex mutex;
+  std::set<int (*)(int)> pointers;
+  std::atomic<int> failures = 0;
+  std::latch all_constructed{thread_count};
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; t++) {
+      threads.emplace_back([&, t] {
+        auto payload = [t](int x) { return x + t; };
+        std::list<banked_closure<signature, decltype(payload), capacity>> own;
+        for (int i = 0; i < per_thread; i++) {
+          own.emplace_back(payload);
+        }
+        all_constructed.arrive_and_wait();
+
+        std::lock_guard const lock{mutex};
+        for (auto const &cls : own) {
+          pointers.insert(cls.get());
+          if (cls.get()(1) != 1 + t) {
+            failures++;
+          }
+        }
+      });
+    }
+  }
+
+  EXPECT_EQ(pointers.size(), thread_count * per_thread);
+  EXPECT_EQ(failures, 0);
+  EXPECT_EQ((banked_closures_in_use<signature, capacity>()), 0);
+}
+
+} // namespace
+} // namespace voidstar::test
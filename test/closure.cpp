@@ -5,12 +5,15 @@
 
 #include <voidstar.h>
 
+#include <atomic>
+#include <functional>
 #include <future>
 #include <list>
 #include <memory>
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace voidstar::test {
 namespace {
@@ -129,6 +132,87 @@ TEST(Closure, NoThreadLocality) {
   EXPECT_EQ(calls, 2);
 }
 
+TEST(Closure, ConcurrentConstruction) {
+  constexpr int thread_count = 8;
+  constexpr int closures_per_thread = 500;
+
+  std::atomic<int> calls = 0;
+
+  {
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < thread_count; t++) {
+      threads.emplace_back([&] {
+        std::list<closure<void(), std::function<void()>>> clses;
+        for (int i = 0; i < closures_per_thread; i++) {
+          clses.emplace_back([&] { calls++; });
+          clses.back().get()();
+          if (i % 3 == 0) {
+            clses.pop_front();
+          }
+        }
+      });
+    }
+  }
+
+  EXPECT_EQ(calls, thread_count * closures_per_thread);
+}
+
+TEST(Closure, CrossThreadDestruction) {
+  // Closures may be freed on a thread other than the one that allocated them
+  constexpr int count = 200;
+
+  int calls = 0;
+  auto payload = [&] { calls++; };
+  using cls_t = closure<void(), decltype(payload)>;
+
+  std::vector<std::unique_ptr<cls_t>> clses;
+  std::jthread{[&] {
+    for (int i = 0; i < count; i++) {
+      clses.push_back(std::make_unique<cls_t>(payload));
+    }
+  }}.join();
+
+  std::jthread{[&] {
+    for (auto &cls : clses) {
+      cls->get()();
+    }
+    clses.clear();
+  }}.join();
+
+  EXPECT_EQ(calls, count);
+
+  // Recycled trampolines work like new ones
+  for (int i = 0; i < count; i++) {
+    cls_t cls{payload};
+    cls.get()();
+  }
+  EXPECT_EQ(calls, 2 * count);
+}
+
+TEST(Closure, TrimCache) {
+  constexpr int count = 500;
+  using cache = detail::ffi::closure_cache;
+
+  trim_closure_cache();
+  auto const before = cache::allocated();
+
+  // Closures destroyed on an exiting thread end up in the depot
+  std::jthread{[&] {
+    std::vector<std::unique_ptr<closure<void(), std::function<void()>>>> clses;
+    for (int i = 0; i < count; i++) {
+      clses.push_back(
+          std::make_unique<closure<void(), std::function<void()>>>([] {}));
+    }
+  }}.join();
+
+  EXPECT_GE(cache::allocated(), before + count);
+  EXPECT_GE(cache::depot_size(), count);
+
+  trim_closure_cache();
+  EXPECT_EQ(cache::depot_size(), 0);
+  EXPECT_EQ(cache::allocated(), before);
+}
+
 TEST(Closure, PayloadGetter) {
   struct payload {
     void operator()() {}
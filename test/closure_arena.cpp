@@ -0,0 +1,149 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_arena.h>
+
+#include <functional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(ClosureArena, MixedSignatures) {
+  closure_arena arena;
+
+  int calls = 0;
+  auto &a = arena.make<void()>([&] { calls++; });
+  auto &b = arena.make<int(int, int)>([](int x, int y) { return x * y; });
+  auto &c = arena.make<double(double)>(
+      std::function<double(double)>{[](double x) { return -x; }});
+
+  a.get()();
+  EXPECT_EQ(calls, 1);
+  EXPECT_EQ(b.get()(6, 7), 42);
+  EXPECT_EQ(c.get()(1.5), -1.5);
+  EXPECT_EQ(arena.size(), 3);
+}
+
+TEST(ClosureArena, ManyClosures) {
+  closure_arena arena{{.data_block_size = 256, .trampolines_per_block = 8}};
+
+  std::vector<int (*)(int)> pointers;
+  for (int i = 0; i < 1000; i++) {
+    pointers.push_back(arena.make<int(int)>([i](int x) { return x + i; }));
+  }
+
+  EXPECT_EQ(std::set(pointers.begin(), pointers.end()).size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(pointers[i](1), i + 1);
+  }
+}
+
+TEST(ClosureArena, ReleaseRunsDestructors) {
+  std::vector<int> destroyed;
+
+  struct payload {
+    std::vector<int> *destroyed;
+    int id;
+    payload(std::vector<int> *destroyed, int id)
+        : destroyed{destroyed}, id{id} {}
+    payload(payload const &) = delete;
+    ~payload() { destroyed->push_back(id); }
+    void operator()() {}
+  };
+
+  closure_arena arena;
+  for (int i = 0; i < 3; i++) {
+    arena.emplace<void(), payload>(&destroyed, i);
+  }
+
+  arena.release();
+  EXPECT_EQ(destroyed, (std::vector<int>{2, 1, 0}));
+  EXPECT_EQ(arena.size(), 0);
+}
+
+TEST(ClosureArena, DestructorReleases) {
+  int alive = 0;
+
+  struct payload {
+    int *alive;
+    explicit payload(int *alive) : alive{alive} { (*alive)++; }
+    payload(payload const &) = delete;
+    ~payload() { (*alive)--; }
+    void operator()() {}
+  };
+
+  {
+    closure_arena arena;
+    arena.emplace<void(), payload>(&alive);
+    arena.emplace<void(), payload>(&alive);
+    EXPECT_EQ(alive, 2);
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(ClosureArena, TrivialPayloadsSkipCleanup) {
+  struct trivial {
+    int value;
+    auto operator()() const -> int { return value; }
+  };
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY and not defined(VOIDSTAR_CLOSURE_METRICS)
+  static_assert(std::is_trivially_destructible_v<arena_closure<int(), trivial>>);
+#endif
+
+  closure_arena arena;
+  EXPECT_EQ((arena.emplace<int(), trivial>(5).get()()), 5);
+}
+
+TEST(ClosureArena, ReuseAfterRelease) {
+  closure_arena arena{{.data_block_size = 128, .trampolines_per_block = 4}};
+
+  for (int round = 0; round < 5; round++) {
+    std::vector<int (*)()> pointers;
+    for (int i = 0; i < 20; i++) {
+      pointers.push_back(
+          arena.make<int()>([round, i] { return round * 100 + i; }));
+    }
+    for (int i = 0; i < 20; i++) {
+      EXPECT_EQ(pointers[i](), round * 100 + i);
+    }
+    arena.release();
+  }
+}
+
+TEST(ClosureArena, ConstructorThrows) {
+  struct payload {
+    explicit payload(bool fail) {
+      if (fail) {
+        throw std::runtime_error{"payload"};
+      }
+    }
+    auto operator()() const -> int { return 1; }
+  };
+
+  closure_arena arena;
+  EXPECT_THROW((arena.emplace<int(), payload>(true)), std::runtime_error);
+  EXPECT_EQ(arena.size(), 0);
+  EXPECT_EQ((arena.emplace<int(), payload>(false).get()()), 1);
+}
+
+TEST(ClosureArena, LargePayload) {
+  struct payload {
+    char data[100000] = {};
+    auto operator()() const -> int { return data[0] + 3; }
+  };
+
+  closure_arena arena;
+  EXPECT_EQ((arena.emplace<int(), payload>().get()()), 3);
+}
+
+} // namespace
+} // namespace voidstar::test
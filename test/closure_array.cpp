@@ -0,0 +1,145 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_array.h>
+
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+struct add {
+  int value;
+  auto operator()(int x) const -> int { return x + value; }
+};
+
+using example_array = closure_array<int(int), add>;
+
+static_assert(std::is_nothrow_move_constructible_v<example_array>);
+static_assert(not std::is_copy_constructible_v<example_array>);
+
+TEST(ClosureArray, CopiesOfPayload) {
+  closure_array<int(int), add> closures{100, add{5}};
+
+  ASSERT_EQ(closures.size(), 100);
+  for (std::size_t i = 0; i < closures.size(); i++) {
+    EXPECT_EQ(closures.get(i)(static_cast<int>(i)), static_cast<int>(i) + 5);
+  }
+}
+
+TEST(ClosureArray, MakeClosures) {
+  auto closures = make_closures<int(int)>(
+      std::views::iota(0, 1000) |
+      std::views::transform([](int i) { return add{i}; }));
+
+  ASSERT_EQ(closures.size(), 1000);
+
+  std::set<int (*)(int)> distinct;
+  for (std::size_t i = 0; i < closures.size(); i++) {
+    EXPECT_EQ(closures.get(i)(1), static_cast<int>(i) + 1);
+    EXPECT_EQ(closures[i].payload().value, static_cast<int>(i));
+    distinct.insert(closures.get(i));
+  }
+  EXPECT_EQ(distinct.size(), closures.size());
+}
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+TEST(ClosureArray, ContiguousTrampolines) {
+  closure_array<int(int), add> closures{10, add{0}};
+
+  auto const address = [&](std::size_t i) {
+    return reinterpret_cast<std::uintptr_t>(closures.get(i));
+  };
+
+  auto const stride = address(1) - address(0);
+  for (std::size_t i = 1; i < closures.size(); i++) {
+    EXPECT_EQ(address(i) - address(i - 1), stride);
+  }
+}
+#endif
+
+TEST(ClosureArray, Empty) {
+  closure_array<int(int), add> closures{std::vector<add>{}};
+  EXPECT_TRUE(closures.empty());
+  EXPECT_EQ(closures.begin(), closures.end());
+}
+
+TEST(ClosureArray, Move) {
+  auto closures = make_closures<int(int)>(std::vector<add>{{1}, {2}});
+  auto *const ptr = closures.get(1);
+
+  auto moved = std::move(closures);
+  EXPECT_TRUE(closures.empty()); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(moved.get(1), ptr);
+  EXPECT_EQ(ptr(0), 2);
+}
+
+TEST(ClosureArray, PayloadLifetime) {
+  int alive = 0;
+
+  struct payload {
+    int *alive;
+    explicit payload(int *alive) : alive{alive} { (*alive)++; }
+    payload(payload const &) = delete;
+    ~payload() { (*alive)--; }
+    void operator()() {}
+  };
+
+  {
+    closure_array<void(), payload> closures{50, &alive};
+    EXPECT_EQ(alive, 50);
+    for (auto &cls : closures) {
+      cls.get()();
+    }
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(ClosureArray, ConstructorThrows) {
+  int alive = 0;
+
+  struct payload {
+    int *alive;
+    explicit payload(std::pair<int, int *> args) : alive{args.second} {
+      if (args.first == 7) {
+        throw std::runtime_error{"payload"};
+      }
+      (*alive)++;
+    }
+    payload(payload const &) = delete;
+    ~payload() { (*alive)--; }
+    void operator()() {}
+  };
+
+  auto const args = std::views::iota(0, 10) | std::views::transform([&](int i) {
+                      return std::pair{i, &alive};
+                    });
+
+  EXPECT_THROW((closure_array<void(), payload>{args}), std::runtime_error);
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(ClosureArray, TypeErasedPayloads) {
+  using payload = std::function<double(double, long)>;
+
+  auto closures = make_closures<double(double, long)>(std::vector<payload>{
+      [](double d, long) { return d; },
+      [](double, long l) { return static_cast<double>(l); },
+  });
+
+  EXPECT_EQ(closures.get(0)(4.5, 3), 4.5);
+  EXPECT_EQ(closures.get(1)(4.5, 3), 3.0);
+}
+
+} // namespace
+} // namespace voidstar::test
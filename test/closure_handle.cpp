@@ -0,0 +1,136 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+using example_unique = unique_closure<void(), void (*)()>;
+using example_shared = shared_closure<void(), void (*)()>;
+
+static_assert(std::is_nothrow_move_constructible_v<example_unique>);
+static_assert(std::is_nothrow_move_assignable_v<example_unique>);
+static_assert(not std::is_copy_constructible_v<example_unique>);
+
+static_assert(std::is_nothrow_move_constructible_v<example_shared>);
+static_assert(std::is_copy_constructible_v<example_shared>);
+
+TEST(UniqueClosure, SimpleCall) {
+  int calls = 0;
+
+  auto cls = make_unique_closure<void()>([&] { calls++; });
+  EXPECT_EQ(calls, 0);
+  cls.get()();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(UniqueClosure, MoveKeepsPointer) {
+  int calls = 0;
+
+  auto cls = make_unique_closure<void()>([&] { calls++; });
+  void (*const ptr)() = cls;
+
+  auto moved = std::move(cls);
+  EXPECT_FALSE(cls); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(cls.get(), nullptr);
+  EXPECT_TRUE(moved);
+  EXPECT_EQ(moved.get(), ptr);
+
+  ptr();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(UniqueClosure, PayloadLifetime) {
+  int value = 0;
+
+  struct payload {
+    int &value;
+    explicit payload(int &value) : value{value} {}
+    payload(payload const &) = delete;
+    ~payload() { value++; }
+    void operator()() {}
+  };
+
+  {
+    unique_closure<void(), payload> cls{value};
+    auto moved = std::move(cls);
+    EXPECT_EQ(value, 0);
+    moved.reset();
+    EXPECT_EQ(value, 1);
+  }
+  EXPECT_EQ(value, 1);
+}
+
+TEST(UniqueClosure, Vector) {
+  constexpr std::size_t N = 1000;
+
+  std::array<int, N> targets{};
+
+  auto make_payload = [&](int i) {
+    return [i, &targets] { targets.at(i) = i; };
+  };
+  using cls_t = unique_closure<void(), decltype(make_payload(0))>;
+
+  // Reallocations must not invalidate function pointers
+  std::vector<cls_t> clses;
+  std::vector<void (*)()> ptrs;
+  for (std::size_t i = 0; i < N; i++) {
+    clses.emplace_back(make_payload(i));
+    ptrs.push_back(clses.back().get());
+  }
+
+  for (auto *ptr : ptrs) {
+    ptr();
+  }
+
+  for (std::size_t i = 0; i < N; i++) {
+    EXPECT_EQ(targets[i], i);
+  }
+}
+
+TEST(UniqueClosure, PayloadGetter) {
+  struct payload {
+    void operator()() {}
+    int value = 0;
+  };
+
+  unique_closure<void(), payload> cls;
+
+  EXPECT_EQ(cls.payload().value, 0);
+  cls.payload().value = 42;
+  EXPECT_EQ(std::as_const(cls).payload().value, 42);
+}
+
+TEST(SharedClosure, Copies) {
+  int value = 0;
+
+  struct payload {
+    int &value;
+    explicit payload(int &value) : value{value} {}
+    payload(payload const &) = delete;
+    ~payload() { value++; }
+    void operator()() { value += 10; }
+  };
+
+  shared_closure<void(), payload> cls{value};
+  auto copy = cls;
+  EXPECT_EQ(copy.get(), cls.get());
+
+  cls.reset();
+  EXPECT_EQ(value, 0);
+  copy.get()();
+  EXPECT_EQ(value, 10);
+
+  copy.reset();
+  EXPECT_EQ(value, 11);
+}
+
+} // namespace
+} // namespace voidstar::test
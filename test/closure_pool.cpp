@@ -0,0 +1,146 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_pool.h>
+
+#include <chrono>
+#include <list>
+#include <optional>
+#include <thread>
+
+namespace voidstar::test {
+namespace {
+
+TEST(ClosurePool, SimpleCall) {
+  closure_pool<int(int)> pool;
+
+  int calls = 0;
+  auto cls = make_closure<int(int)>(pool, [&](int x) {
+    calls++;
+    return x * 2;
+  });
+
+  EXPECT_EQ(calls, 0);
+  EXPECT_EQ(cls.get()(21), 42);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(ClosurePool, Prefill) {
+  closure_pool<void()> pool{{
+      .low_watermark = 4,
+      .high_watermark = 16,
+      .background_refill = false,
+  }};
+
+  EXPECT_EQ(pool.size(), 16);
+}
+
+TEST(ClosurePool, Recycling) {
+  closure_pool<void()> pool{{
+      .low_watermark = 0,
+      .high_watermark = 1,
+      .background_refill = false,
+  }};
+
+  int calls_a = 0;
+  int calls_b = 0;
+
+  std::optional<pooled_closure<void(), std::function<void()>>> cls;
+
+  cls.emplace(pool, [&] { calls_a++; });
+  void (*const ptr_a)() = cls->get();
+  EXPECT_EQ(pool.size(), 0);
+  ptr_a();
+  cls.reset();
+  EXPECT_EQ(pool.size(), 1);
+
+  cls.emplace(pool, [&] { calls_b++; });
+  void (*const ptr_b)() = cls->get();
+  EXPECT_EQ(ptr_a, ptr_b);
+  ptr_b();
+
+  EXPECT_EQ(calls_a, 1);
+  EXPECT_EQ(calls_b, 1);
+}
+
+TEST(ClosurePool, EmptyPool) {
+  closure_pool<void()> pool{{
+      .low_watermark = 0,
+      .high_watermark = 0,
+      .background_refill = false,
+  }};
+
+  int calls = 0;
+  auto cls = make_closure<void()>(pool, [&] { calls++; });
+  cls.get()();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(ClosurePool, Trim) {
+  closure_pool<void()> pool{{
+      .low_watermark = 0,
+      .high_watermark = 32,
+      .background_refill = false,
+  }};
+
+  // Trimmed closures are freed, not cached
+  auto const allocated = detail::ffi::closure_cache::allocated();
+  pool.trim(8);
+  EXPECT_EQ(pool.size(), 8);
+  EXPECT_EQ(detail::ffi::closure_cache::allocated(), allocated - 24);
+  pool.trim();
+  EXPECT_EQ(pool.size(), 0);
+  EXPECT_EQ(detail::ffi::closure_cache::allocated(), allocated - 32);
+}
+
+TEST(ClosurePool, BackgroundRefill) {
+  closure_pool<void()> pool{{
+      .low_watermark = 8,
+      .high_watermark = 16,
+      .background_refill = true,
+  }};
+
+  auto payload = [] {};
+  std::list<pooled_closure<void(), decltype(payload)>> clses;
+  for (int i = 0; i < 12; i++) {
+    clses.emplace_back(pool, payload);
+  }
+
+  auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds{10};
+  while (pool.size() < 8 and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_GE(pool.size(), 8);
+}
+
+TEST(ClosurePool, ManyClosures) {
+  constexpr std::size_t N = 1000;
+
+  closure_pool<void()> pool;
+  std::array<int, N> targets{};
+
+  auto make_payload = [&](int i) {
+    return [i, &targets] { targets.at(i) = i; };
+  };
+  using cls_t = pooled_closure<void(), decltype(make_payload(0))>;
+
+  std::list<cls_t> clses;
+  for (std::size_t i = 0; i < N; i++) {
+    clses.emplace_back(pool, make_payload(i));
+  }
+
+  for (auto const &cls : clses) {
+    cls.get()();
+  }
+
+  for (std::size_t i = 0; i < N; i++) {
+    EXPECT_EQ(targets[i], i);
+  }
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,208 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_registry.h>
+#include <voidstar/direct_closure.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <typeindex>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(ClosureRegistry, FindByFunctionPointer) {
+  auto const add_one = [](int x) { return x + 1; };
+  auto cls = make_registered_closure<int(int)>(add_one);
+
+  auto const info = find_closure(cls.get());
+  ASSERT_TRUE(info.has_value());
+  EXPECT_EQ(info->entry_point, reinterpret_cast<void const *>(cls.get()));
+  EXPECT_EQ(info->signature, std::type_index{typeid(int (*)(int))});
+  EXPECT_EQ(info->payload, std::type_index{typeid(add_one)});
+  EXPECT_TRUE(is_live(*info));
+  EXPECT_EQ(cls.get()(1), 2);
+}
+
+TEST(ClosureRegistry, FindInsideTrampoline) {
+  auto cls = make_registered_closure<void()>([] {});
+  auto const *const entry = reinterpret_cast<char const *>(cls.get());
+
+  auto const inside = find_closure(entry + 1);
+  ASSERT_TRUE(inside.has_value());
+  EXPECT_EQ(inside->entry_point, entry);
+
+  auto const last = find_closure(entry + inside->code_size - 1);
+  ASSERT_TRUE(last.has_value());
+  EXPECT_EQ(last->id, inside->id);
+
+  auto const before = find_closure(entry - 1);
+  EXPECT_TRUE(not before.has_value() or before->entry_point != entry);
+}
+
+TEST(ClosureRegistry, UnregisteredClosuresNotFound) {
+  auto cls = make_closure<void()>([] {});
+  EXPECT_FALSE(find_closure(cls.get()).has_value());
+
+  int local = 0;
+  EXPECT_FALSE(find_closure(&local).has_value());
+}
+
+TEST(ClosureRegistry, Unregister) {
+  auto const count = registered_closure_count();
+
+  std::optional<closure_info> info;
+  {
+    auto cls = make_registered_closure<int()>([] { return 0; });
+    EXPECT_EQ(registered_closure_count(), count + 1);
+    info = find_closure(cls.get());
+    ASSERT_TRUE(info.has_value());
+    EXPECT_TRUE(is_live(*info));
+  }
+
+  EXPECT_EQ(registered_closure_count(), count);
+  EXPECT_FALSE(is_live(*info));
+  EXPECT_FALSE(find_closure(info->entry_point).has_value());
+}
+
+TEST(ClosureRegistry, ReusedAddressIsNotLive) {
+  std::optional<closure_info> first;
+  {
+    registered<direct_closure<void(), void (*)()>> cls{[] {}};
+    first = find_closure(cls.get());
+    ASSERT_TRUE(first.has_value());
+  }
+
+  registered<direct_closure<void(), void (*)()>> cls{[] {}};
+  auto const second = find_closure(cls.get());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_NE(first->id, second->id);
+  EXPECT_FALSE(is_live(*first));
+  EXPECT_TRUE(is_live(*second));
+}
+
+TEST(ClosureRegistry, ManyClosures) {
+  constexpr std::size_t count = 2000;
+
+  std::vector<std::unique_ptr<registered_closure<int(), int (*)()>>> closures;
+  closures.reserve(count);
+  for (std::size_t i = 0; i < count; i++) {
+    closures.push_back(
+        std::make_unique<registered_closure<int(), int (*)()>>(
+            [] { return 0; }));
+  }
+
+  for (auto const &cls : closures) {
+    auto const info = find_closure(cls->get());
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->closure, static_cast<void const *>(cls.get()));
+  }
+
+  for (std::size_t i = 0; i < count; i += 2) {
+    closures[i].reset();
+  }
+  for (std::size_t i = 1; i < count; i += 2) {
+    EXPECT_TRUE(find_closure(closures[i]->get()).has_value());
+  }
+}
+
+static_assert(noexcept(find_closure(static_cast<void const *>(nullptr))));
+
+TEST(ClosureRegistry, CodeSizeOfTrampoline) {
+  auto cls = make_registered_closure<void()>([] {});
+  auto const info = find_closure(cls.get());
+  ASSERT_TRUE(info.has_value());
+  EXPECT_EQ(info->code_size, std::size_t{FFI_TRAMPOLINE_SIZE});
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+  registered<direct_closure<int(int), int (*)(int)>> direct{
+      [](int x) { return x; }};
+  auto const direct_info = find_closure(direct.get());
+  ASSERT_TRUE(direct_info.has_value());
+  namespace x86_64 = detail::native::x86_64;
+  EXPECT_TRUE(direct_info->code_size == x86_64::near_context_stub_size or
+              direct_info->code_size == x86_64::context_stub_size);
+  EXPECT_FALSE(find_closure(reinterpret_cast<char const *>(direct.get()) +
+                            direct_info->code_size)
+                   .has_value());
+#endif
+}
+
+TEST(ClosureRegistry, RandomRegistrationOrder) {
+  using registered_type = registered_closure<int(), int (*)()>;
+  constexpr std::size_t count = 1000;
+
+  std::mt19937 random{42};
+  std::vector<std::unique_ptr<registered_type>> live;
+  std::vector<closure_info> removed;
+  auto const base_count = registered_closure_count();
+
+  for (std::size_t i = 0; i < count; i++) {
+    live.push_back(std::make_unique<registered_type>([] { return 0; }));
+
+    // Unregister a random closure about every third step
+    if (random() % 3 == 0) {
+      auto const victim = random() % live.size();
+      removed.push_back(*find_closure(live[victim]->get()));
+      std::swap(live[victim], live.back());
+      live.pop_back();
+    }
+  }
+
+  EXPECT_EQ(registered_closure_count(), base_count + live.size());
+  for (auto const &cls : live) {
+    auto const info = find_closure(cls->get());
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->closure, static_cast<void const *>(cls.get()));
+  }
+  for (auto const &info : removed) {
+    EXPECT_FALSE(is_live(info));
+  }
+
+  // Unregistering most closures rebuilds the index without the dead entries
+  live.resize(live.size() / 10);
+  EXPECT_EQ(registered_closure_count(), base_count + live.size());
+  for (auto const &cls : live) {
+    EXPECT_TRUE(find_closure(cls->get()).has_value());
+  }
+}
+
+TEST(ClosureRegistry, ConcurrentLookups) {
+  auto cls = make_registered_closure<int()>([] { return 1; });
+  auto const fn = cls.get();
+
+  std::atomic<bool> stop{false};
+  std::atomic<int> misses{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 2; i++) {
+    readers.emplace_back([&] {
+      while (not stop.load(std::memory_order_relaxed)) {
+        if (not find_closure(fn).has_value()) {
+          misses.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  for (int i = 0; i < 200; i++) {
+    auto churn = make_registered_closure<void()>([] {});
+    EXPECT_TRUE(find_closure(churn.get()).has_value());
+  }
+
+  stop = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(misses.load(), 0);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,146 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/direct_closure.h>
+
+#include <cstdint>
+#include <list>
+#include <thread>
+
+namespace voidstar::test {
+namespace {
+
+template <typename F>
+constexpr bool is_direct =
+    detail::native::supports_direct<detail::call_signature<F>>;
+
+struct struct_int_float {
+  int x;
+  float y;
+};
+
+} // namespace
+} // namespace voidstar::test
+
+template <> struct voidstar::layout<voidstar::test::struct_int_float> {
+  using members = std::tuple<int, float>;
+};
+
+namespace voidstar::test {
+namespace {
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+static_assert(is_direct<void()>);
+static_assert(is_direct<int(int, double, void *)>);
+static_assert(is_direct<void (*)(int, int, int, int, int)>);
+static_assert(is_direct<float(double, double, double, double, double, double,
+                              double, double, double, double)>);
+static_assert(is_direct<bool(char, std::uint8_t, std::int64_t)>);
+#endif
+
+// Not enough registers for the context
+static_assert(not is_direct<void(int, int, int, int, int, int)>);
+
+// Not a single-register type
+static_assert(not is_direct<void(long double)>);
+static_assert(not is_direct<long double()>);
+static_assert(not is_direct<void(struct_int_float)>);
+static_assert(not is_direct<struct_int_float()>);
+
+TEST(DirectClosure, SimpleCall) {
+  int calls = 0;
+
+  auto cls = make_direct_closure<void()>([&] { calls++; });
+  EXPECT_EQ(calls, 0);
+  cls.get()();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(DirectClosure, MixedArguments) {
+  int offset = 1000;
+
+  auto cls = make_direct_closure<std::int64_t(int, double, char, void *, long,
+                                              float)>(
+      [&](int a, double b, char c, void *p, long d, float e) -> std::int64_t {
+        EXPECT_EQ(p, &offset);
+        return offset + a + static_cast<std::int64_t>(b) + c + d +
+               static_cast<std::int64_t>(e);
+      });
+
+  EXPECT_EQ(cls.get()(1, 20.0, 3, &offset, 40, 5.0f), 1069);
+}
+
+TEST(DirectClosure, AllIntegerRegisters) {
+  auto cls = make_direct_closure<int(int, int, int, int, int)>(
+      [](int a, int b, int c, int d, int e) {
+        return a * 10000 + b * 1000 + c * 100 + d * 10 + e;
+      });
+
+  EXPECT_EQ(cls.get()(1, 2, 3, 4, 5), 12345);
+}
+
+TEST(DirectClosure, FloatsOnStack) {
+  // Ten doubles: the last two are passed on the stack
+  auto cls = make_direct_closure<double(int, double, double, double, double,
+                                        double, double, double, double, double,
+                                        double)>(
+      [](int n, double a, double b, double c, double d, double e, double f,
+         double g, double h, double i, double j) {
+        return n + a + b + c + d + e + f + g + h + i + j;
+      });
+
+  EXPECT_EQ(cls.get()(1, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0),
+            56.0);
+}
+
+TEST(DirectClosure, NarrowReturnTypes) {
+  auto is_odd = make_direct_closure<bool(int)>([](int x) { return x % 2; });
+  EXPECT_TRUE(is_odd.get()(3));
+  EXPECT_FALSE(is_odd.get()(4));
+
+  auto negate = make_direct_closure<std::int8_t(std::int8_t)>(
+      [](std::int8_t x) { return static_cast<std::int8_t>(-x); });
+  EXPECT_EQ(negate.get()(5), -5);
+
+  auto half = make_direct_closure<float(float)>([](float x) { return x / 2; });
+  EXPECT_EQ(half.get()(3.0f), 1.5f);
+}
+
+TEST(DirectClosure, FallbackToFfi) {
+  auto cls = make_direct_closure<float(struct_int_float)>(
+      [](struct_int_float s) { return s.x + s.y; });
+
+  EXPECT_EQ(cls.get()(struct_int_float{.x = 1, .y = 0.5f}), 1.5f);
+}
+
+TEST(DirectClosure, ManyClosures) {
+  constexpr std::size_t N = 5000;
+
+  auto make_payload = [](int i) { return [i](int x) { return x + i; }; };
+  using cls_t = direct_closure<int(int), decltype(make_payload(0))>;
+
+  std::list<cls_t> clses;
+  for (std::size_t i = 0; i < N; i++) {
+    clses.emplace_back(make_payload(static_cast<int>(i)));
+  }
+
+  int i = 0;
+  for (auto const &cls : clses) {
+    EXPECT_EQ(cls.get()(1), i + 1);
+    i++;
+  }
+}
+
+TEST(DirectClosure, NoThreadLocality) {
+  int calls = 0;
+
+  auto cls = make_direct_closure<void(int)>([&](int x) { calls += x; });
+  std::jthread{[&] { cls.get()(2); }}.join();
+  EXPECT_EQ(calls, 2);
+}
+
+} // namespace
+} // namespace voidstar::test
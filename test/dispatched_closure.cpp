@@ -0,0 +1,211 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/dispatched_closure.h>
+#include <voidstar/work_stealing_pool.h>
+
+#include <atomic>
+#include <functional>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+/// @brief Runs tasks on the submitting thread.
+struct inline_executor {
+  int submitted = 0;
+
+  template <typename F> void submit(F &&fun) {
+    submitted++;
+    fun();
+  }
+};
+
+/// @brief Keeps tasks until told to run them.
+struct manual_executor {
+  std::vector<std::function<void()>> tasks;
+
+  template <typename F> void submit(F &&fun) {
+    tasks.emplace_back(std::forward<F>(fun));
+  }
+
+  void run_all() {
+    for (auto &task : tasks) {
+      task();
+    }
+    tasks.clear();
+  }
+};
+
+TEST(DispatchedClosure, VoidCallsAreAsynchronous) {
+  manual_executor executor;
+  std::vector<int> values;
+
+  auto cls = make_dispatched_closure<void(int)>(
+      executor, [&](int x) { values.push_back(x); });
+
+  cls.get()(1);
+  cls.get()(2);
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(executor.tasks.size(), 2);
+
+  executor.run_all();
+  EXPECT_EQ(values, (std::vector<int>{1, 2}));
+}
+
+TEST(DispatchedClosure, RunsOnPool) {
+  work_stealing_pool pool{2};
+  auto const caller = std::this_thread::get_id();
+
+  std::atomic<int> on_caller = 0;
+  std::atomic<int> sum = 0;
+  {
+    auto cls = make_dispatched_closure<void(int)>(pool, [&](int x) {
+      if (std::this_thread::get_id() == caller) {
+        on_caller++;
+      }
+      sum += x;
+    });
+
+    for (int i = 1; i <= 100; i++) {
+      cls.get()(i);
+    }
+    // The destructor waits for dispatched calls
+  }
+  EXPECT_EQ(sum, 5050);
+  EXPECT_EQ(on_caller, 0);
+}
+
+TEST(DispatchedClosure, WaitIdle) {
+  work_stealing_pool pool{1};
+  std::latch release{1};
+  std::atomic<bool> finished = false;
+
+  auto cls = make_dispatched_closure<void()>(pool, [&] {
+    release.wait();
+    finished = true;
+  });
+
+  cls.get()();
+  EXPECT_EQ(cls.payload().pending(), 1);
+
+  release.count_down();
+  cls.payload().wait_idle();
+  EXPECT_TRUE(finished);
+  EXPECT_EQ(cls.payload().pending(), 0);
+}
+
+TEST(DispatchedClosure, ResultRendezvous) {
+  work_stealing_pool pool{2};
+
+  auto cls = make_dispatched_closure<int(int, int)>(pool, [&](int a, int b) {
+    EXPECT_TRUE(pool.running_in_this_thread());
+    return a * b;
+  });
+
+  EXPECT_EQ(cls.get()(6, 7), 42);
+}
+
+TEST(DispatchedClosure, ResultInlineOnPoolThread) {
+  work_stealing_pool pool{1};
+
+  auto cls = make_dispatched_closure<int(int)>(pool, [](int x) { return x + 1; });
+  auto fn = cls.get();
+
+  // With a single worker, a rendezvous from the worker would deadlock
+  std::latch done{1};
+  int result = 0;
+  pool.submit([&] {
+    result = fn(41);
+    done.count_down();
+  });
+  done.wait();
+  EXPECT_EQ(result, 42);
+}
+
+TEST(DispatchedClosure, CustomExecutor) {
+  inline_executor executor;
+
+  dispatched_closure<double(double), std::negate<>, inline_executor> cls{
+      executor};
+  EXPECT_EQ(cls.get()(1.5), -1.5);
+  EXPECT_EQ(executor.submitted, 1);
+}
+
+/// @brief Throws for negative arguments.
+struct thrower {
+  auto operator()(int x) const -> int {
+    if (x < 0) {
+      throw std::invalid_argument{"negative"};
+    }
+    return x;
+  }
+};
+
+static_assert(std::is_nothrow_invocable_v<
+              detail::dispatcher<detail::call_signature<int(int)>, thrower,
+                                 work_stealing_pool> &,
+              int>);
+
+auto call_thrower(int x) -> int {
+  work_stealing_pool pool{1};
+  dispatched_closure<int(int), thrower> cls{pool};
+  return cls.get()(x);
+}
+
+TEST(DispatchedClosure, RendezvousExceptionTerminates) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  EXPECT_DEATH(call_thrower(-1), "");
+  EXPECT_EQ(call_thrower(3), 3);
+}
+
+/// @brief Fails to accept any task.
+struct rejecting_executor {
+  template <typename F> void submit(F && /* fun */) {
+    throw std::runtime_error{"rejected"};
+  }
+};
+
+void call_rejected() {
+  rejecting_executor executor;
+  auto cls = make_dispatched_closure<void(int)>(executor, [](int) {});
+  cls.get()(1);
+}
+
+TEST(DispatchedClosure, SubmitExceptionTerminates) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+  EXPECT_DEATH(call_rejected(), "");
+}
+
+TEST(DispatchedClosure, ConcurrentCallers) {
+  constexpr int thread_count = 4;
+  constexpr int calls_per_thread = 1000;
+
+  work_stealing_pool pool{2};
+  std::atomic<long> sum = 0;
+  {
+    auto cls = make_dispatched_closure<void(long)>(
+        pool, [&](long x) { sum += x; });
+    auto fn = cls.get();
+
+    std::vector<std::jthread> callers;
+    for (int t = 0; t < thread_count; t++) {
+      callers.emplace_back([fn] {
+        for (int i = 0; i < calls_per_thread; i++) {
+          fn(1);
+        }
+      });
+    }
+  }
+  EXPECT_EQ(sum, thread_count * calls_per_thread);
+}
+
+} // namespace
+} // namespace voidstar::test
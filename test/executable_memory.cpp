@@ -0,0 +1,124 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/executable_memory.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace voidstar::test {
+namespace {
+
+namespace native = detail::native;
+
+#if VOIDSTAR_HAS_EXECUTABLE_MEMORY
+
+TEST(ExecutableMemory, CountsMappedBytes) {
+  auto const before = collect_executable_memory_stats();
+  {
+    native::executable_block const block{1};
+    auto const during = collect_executable_memory_stats();
+    EXPECT_EQ(during.mapped_bytes, before.mapped_bytes + block.size());
+    EXPECT_EQ(during.mapped_pages, before.mapped_pages + 1);
+  }
+  EXPECT_EQ(collect_executable_memory_stats().mapped_bytes,
+            before.mapped_bytes);
+}
+
+TEST(ExecutableMemory, HugePageBlocksRoundUp) {
+  auto const before = collect_executable_memory_stats();
+
+  native::executable_block const block{1, {.huge_pages = true}};
+  EXPECT_EQ(block.size(), native::huge_page_size);
+
+  auto const after = collect_executable_memory_stats();
+  EXPECT_EQ(after.huge_page_bytes,
+            before.huge_page_bytes + (block.huge_pages() ? block.size() : 0));
+}
+
+TEST(ExecutableMemory, NearTextPlacement) {
+  auto const before = collect_executable_memory_stats();
+
+  native::executable_block const block{
+      native::huge_page_size,
+      {.huge_pages = true, .near = native::text_anchor()}};
+
+  ASSERT_TRUE(block.near_text());
+  EXPECT_TRUE(native::is_near(block.executable(), block.size(),
+                              native::text_anchor()));
+  EXPECT_EQ(collect_executable_memory_stats().near_text_bytes,
+            before.near_text_bytes + block.size());
+
+  // Both views share the same memory
+  block.writable()[5] = std::byte{42};
+  EXPECT_EQ(static_cast<std::byte const *>(block.executable())[5],
+            std::byte{42});
+}
+
+TEST(ExecutableMemory, StubOccupancy) {
+  auto &allocator = native::stub_allocator::instance();
+  auto const before = collect_executable_memory_stats();
+
+  auto const a = allocator.allocate();
+  auto const b = allocator.allocate();
+
+  auto const during = collect_executable_memory_stats();
+  EXPECT_EQ(during.stubs_in_use, before.stubs_in_use + 2);
+  EXPECT_GE(during.stub_capacity, during.stubs_in_use);
+  EXPECT_GT(during.near_text_bytes, 0);
+
+  allocator.deallocate(b);
+  allocator.deallocate(a);
+  EXPECT_EQ(collect_executable_memory_stats().stubs_in_use,
+            before.stubs_in_use);
+
+  // Freed stubs are reused first
+  auto const c = allocator.allocate();
+  EXPECT_EQ(c.executable, a.executable);
+  allocator.deallocate(c);
+}
+
+#endif
+
+#if VOIDSTAR_HAS_SYSV_X86_64
+[[gnu::noinline]] auto stub_target(long x) -> long { return x; }
+
+TEST(ExecutableMemory, RelativeJumpEncoding) {
+  std::byte code[native::x86_64::context_stub_size] = {};
+  auto *const target = reinterpret_cast<void *>(&stub_target);
+  auto const target_address = reinterpret_cast<std::uintptr_t>(target);
+
+  auto const near_size = native::x86_64::emit_context_stub(
+      code, reinterpret_cast<void const *>(target_address - 4096),
+      native::x86_64::gp_register::rsi, nullptr, target);
+  EXPECT_EQ(near_size, native::x86_64::near_context_stub_size);
+  EXPECT_EQ(code[14], std::byte{0xE9});
+
+  // jmp rel32 is relative to the end of the stub
+  std::int32_t rel32 = 0;
+  std::memcpy(&rel32, code + 15, sizeof(rel32));
+  EXPECT_EQ(rel32, 4096 - static_cast<std::int32_t>(near_size));
+
+  auto const far_size = native::x86_64::emit_context_stub(
+      code,
+      reinterpret_cast<void const *>(target_address ^ (std::uintptr_t{1} << 40)),
+      native::x86_64::gp_register::rsi, nullptr, target);
+  EXPECT_EQ(far_size, native::x86_64::context_stub_size);
+}
+#endif
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+TEST(ExecutableMemory, DirectClosuresNearText) {
+  auto cls = make_direct_closure<long(long)>([](long x) { return x * 2; });
+  EXPECT_EQ(cls.get()(21), 42);
+  EXPECT_GT(collect_executable_memory_stats().near_text_bytes, 0);
+}
+#endif
+
+} // namespace
+} // namespace voidstar::test
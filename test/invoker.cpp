@@ -0,0 +1,74 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/invoker.h>
+
+#include <array>
+#include <cstdint>
+
+namespace voidstar::test {
+namespace {
+
+auto add(int a, double b) -> double { return a + b; }
+auto sub(int a, double b) -> double { return a - b; }
+auto mul(int a, double b) -> double { return a * b; }
+
+int counter = 0;
+void bump_by(int x) { counter += x; }
+void bump_twice_by(int x) { counter += 2 * x; }
+
+TEST(Invoker, SimpleCall) {
+  invoker<double(int, double)> const invoke;
+  EXPECT_EQ(invoke(&add, 1, 0.5), 1.5);
+  EXPECT_EQ(invoke(&sub, 1, 0.5), 0.5);
+}
+
+TEST(Invoker, PointerSignature) {
+  using fn_ptr = double (*)(int, double);
+  invoker<fn_ptr> const invoke;
+  EXPECT_EQ(invoke(&mul, 3, 0.5), 1.5);
+}
+
+TEST(Invoker, ArgumentConversion) {
+  invoker<double(int, double)> const invoke;
+  EXPECT_EQ(invoke(&add, std::int8_t{2}, 1.0f), 3.0);
+}
+
+TEST(Invoker, Closure) {
+  int calls = 0;
+  auto cls = make_closure<std::uint8_t(std::uint8_t)>([&](std::uint8_t x) {
+    calls++;
+    return static_cast<std::uint8_t>(x + 1);
+  });
+
+  invoker<std::uint8_t(std::uint8_t)> const invoke;
+  EXPECT_EQ(invoke(cls.get(), 254), 255);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(Invoker, CallEachVoid) {
+  std::array<void (*)(int), 3> const fns{&bump_by, &bump_twice_by, &bump_by};
+
+  counter = 0;
+  invoker<void(int)> const invoke;
+  invoke.call_each(fns, 5);
+  EXPECT_EQ(counter, 20);
+}
+
+TEST(Invoker, CallEachWithResults) {
+  std::array<double (*)(int, double), 3> const fns{&add, &sub, &mul};
+  std::array<double, 3> results{};
+
+  invoker<double(int, double)> const invoke;
+  invoke.call_each(fns, results, 4, 2.0);
+
+  EXPECT_EQ(results[0], 6.0);
+  EXPECT_EQ(results[1], 2.0);
+  EXPECT_EQ(results[2], 8.0);
+}
+
+} // namespace
+} // namespace voidstar::test
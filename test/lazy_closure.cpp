@@ -0,0 +1,115 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/lazy_closure.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+/// @brief An `ffi::closure` that counts how many were allocated.
+struct counting_trampoline : detail::ffi::closure {
+  static inline std::atomic<int> allocated = 0;
+  counting_trampoline() { allocated++; }
+};
+
+template <typename F, typename P>
+using counting_lazy_closure = detail::closure_impl<
+    detail::call_signature<F>, P,
+    detail::ffi::lazy_trampoline<counting_trampoline>>;
+
+TEST(LazyClosure, SimpleCall) {
+  int calls = 0;
+
+  auto cls = make_lazy_closure<int(int)>([&](int x) {
+    calls++;
+    return x * 3;
+  });
+
+  EXPECT_EQ(cls.get()(3), 9);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(LazyClosure, PayloadConstructedImmediately) {
+  int constructed = 0;
+
+  struct payload {
+    explicit payload(int &constructed) { constructed++; }
+    void operator()() {}
+  };
+
+  lazy_closure<void(), payload> cls{constructed};
+  EXPECT_EQ(constructed, 1);
+}
+
+TEST(LazyClosure, PreparedOnFirstGet) {
+  auto const before = counting_trampoline::allocated.load();
+
+  counting_lazy_closure<int(), int (*)()> cls{[] { return 5; }};
+  EXPECT_EQ(counting_trampoline::allocated, before);
+
+  int (*const ptr)() = cls;
+  EXPECT_EQ(counting_trampoline::allocated, before + 1);
+  EXPECT_EQ(cls.get(), ptr);
+  EXPECT_EQ(counting_trampoline::allocated, before + 1);
+  EXPECT_EQ(ptr(), 5);
+}
+
+TEST(LazyClosure, NeverPrepared) {
+  auto const before = counting_trampoline::allocated.load();
+  {
+    counting_lazy_closure<void(), void (*)()> cls{[] {}};
+    (void)cls;
+  }
+  EXPECT_EQ(counting_trampoline::allocated, before);
+}
+
+TEST(LazyClosure, ConcurrentFirstGet) {
+  constexpr int thread_count = 8;
+  auto const before = counting_trampoline::allocated.load();
+
+  counting_lazy_closure<int(), int (*)()> cls{[] { return 7; }};
+
+  std::atomic<bool> start = false;
+  std::vector<int (*)()> results(thread_count);
+  {
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < thread_count; i++) {
+      threads.emplace_back([&, i] {
+        while (not start) {
+          std::this_thread::yield();
+        }
+        results[i] = cls.get();
+      });
+    }
+    start = true;
+  }
+
+  EXPECT_EQ(counting_trampoline::allocated, before + 1);
+  for (auto *const result : results) {
+    EXPECT_EQ(result, results[0]);
+    EXPECT_EQ(result(), 7);
+  }
+}
+
+#if VOIDSTAR_HAS_DIRECT_TRAMPOLINES
+TEST(LazyClosure, DirectTrampoline) {
+  using signature = detail::call_signature<long(long)>;
+  detail::closure_impl<
+      signature, long (*)(long),
+      detail::ffi::lazy_trampoline<detail::native::direct_trampoline<signature>>>
+      cls{[](long x) { return x - 1; }};
+
+  EXPECT_EQ(cls.get()(43), 42);
+}
+#endif
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,170 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/metrics.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+#ifndef VOIDSTAR_CLOSURE_METRICS
+static_assert(std::is_same_v<closure<void(), void (*)()>::hooks_type,
+                             detail::no_call_hooks>);
+#endif
+
+auto histogram_total(call_metrics const &metrics) -> std::uint64_t {
+  return std::accumulate(metrics.latency_histogram.begin(),
+                         metrics.latency_histogram.end(), std::uint64_t{0});
+}
+
+auto find_record(std::vector<closure_metrics_record> const &records,
+                 std::type_index payload)
+    -> std::optional<closure_metrics_record> {
+  auto const it = std::find_if(records.begin(), records.end(), [&](auto &r) {
+    return r.payload == payload;
+  });
+  if (it == records.end()) {
+    return std::nullopt;
+  }
+  return *it;
+}
+
+TEST(Metrics, BucketOf) {
+  EXPECT_EQ(call_metrics::bucket_of(0), 0);
+  EXPECT_EQ(call_metrics::bucket_of(1), 1);
+  EXPECT_EQ(call_metrics::bucket_of(2), 2);
+  EXPECT_EQ(call_metrics::bucket_of(3), 2);
+  EXPECT_EQ(call_metrics::bucket_of(1024), 11);
+  EXPECT_EQ(call_metrics::bucket_of(~std::uint64_t{0}),
+            call_metrics::bucket_count - 1);
+}
+
+TEST(Metrics, CountsCalls) {
+  auto cls = make_instrumented_closure<int(int)>([](int x) { return x * 2; });
+
+  EXPECT_EQ(closure_metrics(cls).calls, 0);
+
+  EXPECT_EQ(cls.get()(1), 2);
+  EXPECT_EQ(cls.get()(2), 4);
+  EXPECT_EQ(cls.get()(3), 6);
+
+  auto const metrics = closure_metrics(cls);
+  EXPECT_EQ(metrics.calls, 3);
+  EXPECT_EQ(metrics.max_concurrent_calls, 1);
+  EXPECT_EQ(histogram_total(metrics), 3);
+}
+
+TEST(Metrics, MaxConcurrentCalls) {
+  constexpr int thread_count = 3;
+  std::atomic<int> entered = 0;
+
+  auto cls = make_instrumented_closure<void()>([&] {
+    entered++;
+    while (entered < thread_count) {
+      std::this_thread::yield();
+    }
+  });
+
+  {
+    std::vector<std::jthread> callers;
+    for (int i = 0; i < thread_count; i++) {
+      callers.emplace_back(cls.get());
+    }
+  }
+
+  auto const metrics = closure_metrics(cls);
+  EXPECT_EQ(metrics.calls, thread_count);
+  EXPECT_EQ(metrics.max_concurrent_calls, thread_count);
+}
+
+TEST(Metrics, Registry) {
+  auto payload = [] {};
+  using payload_type = decltype(payload);
+
+  std::optional<instrumented_closure<void(), payload_type>> a{std::in_place,
+                                                              payload};
+  instrumented_closure<void(), payload_type> b{payload};
+
+  a->get()();
+  a->get()();
+  b.get()();
+  a.reset();
+
+  auto const record =
+      find_record(collect_closure_metrics(), typeid(payload_type));
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->signature, std::type_index{typeid(void (*)())});
+  EXPECT_EQ(record->live_closures, 1);
+  EXPECT_EQ(record->metrics.calls, 3);
+}
+
+TEST(Metrics, RemoveInAnyOrder) {
+  struct payload {
+    void operator()() const {}
+  };
+
+  constexpr int closure_count = 64;
+  std::vector<std::unique_ptr<instrumented_closure<void(), payload>>> clses;
+  for (int i = 0; i < closure_count; i++) {
+    clses.push_back(std::make_unique<instrumented_closure<void(), payload>>());
+    clses.back()->get()();
+  }
+
+  // Unlink from the middle, the front and the back of the list
+  for (int i = 1; i < closure_count; i += 2) {
+    clses[i].reset();
+  }
+  clses.front().reset();
+  clses.back().reset();
+
+  auto record = find_record(collect_closure_metrics(), typeid(payload));
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->live_closures, closure_count / 2 - 1);
+  EXPECT_EQ(record->metrics.calls, closure_count);
+
+  clses.clear();
+  record = find_record(collect_closure_metrics(), typeid(payload));
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(record->live_closures, 0);
+  EXPECT_EQ(record->metrics.calls, closure_count);
+}
+
+TEST(Metrics, AggregateBySignature) {
+  struct payload_a {
+    auto operator()(long x) const -> long { return x; }
+  };
+  struct payload_b {
+    auto operator()(long x) const -> long { return -x; }
+  };
+
+  instrumented_closure<long(long), payload_a> a;
+  instrumented_closure<long(long), payload_b> b;
+  a.get()(1);
+  b.get()(1);
+  b.get()(2);
+
+  auto const records = collect_closure_metrics();
+  auto const by_signature =
+      aggregate_closure_metrics(records, &closure_metrics_record::signature);
+  auto const by_payload =
+      aggregate_closure_metrics(records, &closure_metrics_record::payload);
+
+  EXPECT_GE(by_signature.at(typeid(long (*)(long))).calls, 3);
+  EXPECT_EQ(by_payload.at(typeid(payload_a)).calls, 1);
+  EXPECT_EQ(by_payload.at(typeid(payload_b)).calls, 2);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,230 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/queued_closure.h>
+
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#if VOIDSTAR_HAS_EVENTFD
+#include <poll.h>
+#endif
+
+namespace voidstar::test {
+namespace {
+
+TEST(QueuedClosure, DrainsInOrder) {
+  queued_closure<void(int, double)> queue;
+
+  queue.get()(1, 0.5);
+  queue.get()(2, 1.5);
+  queue.get()(3, 2.5);
+  EXPECT_EQ(queue.stats().depth, 3);
+
+  std::vector<std::pair<int, double>> calls;
+  EXPECT_EQ(queue.drain([&](int a, double b) { calls.emplace_back(a, b); }), 3);
+  EXPECT_EQ(calls, (std::vector<std::pair<int, double>>{
+                       {1, 0.5}, {2, 1.5}, {3, 2.5}}));
+  EXPECT_EQ(queue.stats().depth, 0);
+  EXPECT_EQ(queue.stats().drained, 3);
+  EXPECT_EQ(queue.drain([](int, double) { FAIL(); }), 0);
+}
+
+TEST(QueuedClosure, CapacityRoundsUp) {
+  queued_closure<void()> queue{{.capacity = 5}};
+  EXPECT_EQ(queue.stats().capacity, 8);
+}
+
+TEST(QueuedClosure, DropReturnsConfiguredValues) {
+  queued_closure<int(int)> queue{{
+      .capacity = 2,
+      .accepted_result = 1,
+      .rejected_result = -1,
+  }};
+
+  EXPECT_EQ(queue.get()(10), 1);
+  EXPECT_EQ(queue.get()(20), 1);
+  EXPECT_EQ(queue.get()(30), -1);
+
+  auto const stats = queue.stats();
+  EXPECT_EQ(stats.depth, 2);
+  EXPECT_EQ(stats.dropped, 1);
+
+  std::vector<int> values;
+  queue.drain([&](int x) { values.push_back(x); });
+  EXPECT_EQ(values, (std::vector<int>{10, 20}));
+  EXPECT_EQ(queue.get()(40), 1);
+}
+
+TEST(QueuedClosure, MaxBatchKeepsSignal) {
+  queued_closure<void(int)> queue;
+  for (int i = 0; i < 5; i++) {
+    queue.get()(i);
+  }
+
+  std::vector<int> values;
+  EXPECT_EQ(queue.drain([&](int x) { values.push_back(x); }, 2), 2);
+  EXPECT_EQ(queue.stats().depth, 3);
+
+  // Must not block: calls are left
+  queue.wait();
+  EXPECT_EQ(queue.drain([&](int x) { values.push_back(x); }), 3);
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(QueuedClosure, HandlerThrows) {
+  queued_closure<void(int)> queue;
+  queue.get()(1);
+  queue.get()(2);
+
+  EXPECT_THROW(queue.drain([](int) { throw std::runtime_error{"handler"}; }),
+               std::runtime_error);
+  EXPECT_EQ(queue.stats().depth, 1);
+  EXPECT_EQ(queue.stats().drained, 1);
+
+  int last = 0;
+  EXPECT_EQ(queue.drain([&](int x) { last = x; }), 1);
+  EXPECT_EQ(last, 2);
+}
+
+TEST(QueuedClosure, WaitWakesConsumer) {
+  queued_closure<void(int)> queue;
+
+  int received = 0;
+  std::jthread consumer{[&] {
+    while (received == 0) {
+      queue.wait();
+      queue.drain([&](int x) { received = x; });
+    }
+  }};
+
+  queue.get()(42);
+  consumer.join();
+  EXPECT_EQ(received, 42);
+}
+
+#if VOIDSTAR_HAS_EVENTFD
+TEST(QueuedClosure, EventFd) {
+  queued_closure<void(int)> queue{{.eventfd = true}};
+  ASSERT_GE(queue.event_fd(), 0);
+
+  auto readable = [&] {
+    pollfd fd{.fd = queue.event_fd(), .events = POLLIN, .revents = 0};
+    return ::poll(&fd, 1, 0) == 1;
+  };
+
+  EXPECT_FALSE(readable());
+  queue.get()(1);
+  queue.get()(2);
+  EXPECT_TRUE(readable());
+
+  queue.drain([](int) {}, 1);
+  EXPECT_TRUE(readable());
+
+  queue.drain([](int) {});
+  EXPECT_FALSE(readable());
+}
+#endif
+
+TEST(QueuedClosure, ConcurrentProducersDrop) {
+  constexpr int thread_count = 4;
+  constexpr int calls_per_thread = 10000;
+
+  queued_closure<int(int)> queue{{
+      .capacity = 64,
+      .accepted_result = 1,
+      .rejected_result = 0,
+  }};
+
+  std::atomic<int> accepted = 0;
+  std::atomic<int> running = thread_count;
+  long long sum = 0;
+  int drained = 0;
+  {
+    std::vector<std::jthread> producers;
+    for (int t = 0; t < thread_count; t++) {
+      producers.emplace_back([&] {
+        int local = 0;
+        for (int i = 0; i < calls_per_thread; i++) {
+          local += queue.get()(1);
+        }
+        accepted += local;
+        running--;
+      });
+    }
+
+    while (running != 0 or queue.stats().depth != 0) {
+      drained += static_cast<int>(queue.drain([&](int x) { sum += x; }));
+    }
+  }
+
+  auto const stats = queue.stats();
+  EXPECT_EQ(drained, accepted);
+  EXPECT_EQ(sum, accepted);
+  EXPECT_EQ(stats.dropped + stats.drained,
+            std::uint64_t{thread_count} * calls_per_thread);
+}
+
+TEST(QueuedClosure, ConcurrentProducersBlock) {
+  constexpr int thread_count = 4;
+  constexpr int calls_per_thread = 5000;
+  constexpr int total = thread_count * calls_per_thread;
+
+  queued_closure<void(int, int)> queue{
+      {.capacity = 4, .on_overflow = overflow_policy::block}};
+
+  std::vector<int> next(thread_count, 0);
+  bool ordered = true;
+  int drained = 0;
+  {
+    std::vector<std::jthread> producers;
+    for (int t = 0; t < thread_count; t++) {
+      producers.emplace_back([&, t] {
+        for (int i = 0; i < calls_per_thread; i++) {
+          queue.get()(t, i);
+        }
+      });
+    }
+
+    while (drained < total) {
+      queue.wait();
+      drained += static_cast<int>(queue.drain([&](int t, int i) {
+        ordered = ordered and next[t] == i;
+        next[t] = i + 1;
+      }));
+    }
+  }
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(queue.stats().dropped, 0);
+  EXPECT_EQ(queue.stats().drained, total);
+}
+
+TEST(MpscRing, Wraparound) {
+  detail::mpsc_ring<std::tuple<int>> ring{3};
+  EXPECT_EQ(ring.capacity(), 4);
+
+  int expected = 0;
+  int pushed = 0;
+  for (int round = 0; round < 10; round++) {
+    while (ring.try_emplace(pushed)) {
+      pushed++;
+    }
+    EXPECT_EQ(ring.size(), 4);
+    ring.consume(
+        [&](std::tuple<int> &&value) {
+          EXPECT_EQ(std::get<0>(value), expected++);
+        },
+        3);
+    EXPECT_EQ(ring.size(), 1);
+  }
+}
+
+} // namespace
+} // namespace voidstar::test
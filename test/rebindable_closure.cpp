@@ -0,0 +1,135 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/rebindable_closure.h>
+#include <voidstar/retirable_closure.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(RebindableClosure, Rebind) {
+  auto cls = make_rebindable_closure<int(int)>([](int x) { return x + 1; });
+  auto const fn = cls.get();
+  EXPECT_EQ(fn(1), 2);
+
+  cls.payload().rebind([](int x) { return x * 10; });
+  EXPECT_EQ(cls.get(), fn);
+  EXPECT_EQ(fn(1), 10);
+
+  cls.payload().rebind(std::negate<>{});
+  EXPECT_EQ(fn(1), -1);
+}
+
+TEST(RebindableClosure, ConcreteTargetType) {
+  struct scale {
+    int factor;
+    auto operator()(int x) const -> int { return x * factor; }
+  };
+
+  rebindable_closure<int(int), scale> cls{2};
+  EXPECT_EQ(cls.get()(5), 10);
+
+  cls.payload().rebind(3);
+  EXPECT_EQ(cls.get()(5), 15);
+}
+
+TEST(RebindableClosure, OldTargetsReclaimed) {
+  auto token = std::make_shared<int>(0);
+
+  {
+    auto cls = make_rebindable_closure<void()>([token] {});
+    for (int i = 0; i < 10; i++) {
+      cls.payload().rebind([token] {});
+    }
+    wait_for_retired_closures();
+    EXPECT_EQ(token.use_count(), 2);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(RebindableClosure, RebindFromTarget) {
+  rebindable_closure<int()> cls{[] { return 0; }};
+
+  struct next {
+    rebindable_closure<int()> *self;
+    int value;
+    auto operator()() const -> int {
+      self->payload().rebind(next{self, value + 1});
+      return value;
+    }
+  };
+
+  cls.payload().rebind(next{&cls, 1});
+  auto fn = cls.get();
+  EXPECT_EQ(fn(), 1);
+  EXPECT_EQ(fn(), 2);
+  EXPECT_EQ(fn(), 3);
+}
+
+TEST(RebindableClosure, ConcurrentCallsAndRebinds) {
+  constexpr int thread_count = 4;
+  constexpr int rebinds = 500;
+
+  // Every target checks that it is still alive when called
+  struct target {
+    std::shared_ptr<std::atomic<int>> alive;
+    int value;
+
+    target(std::shared_ptr<std::atomic<int>> alive, int value)
+        : alive{std::move(alive)}, value{value} {
+      (*this->alive)++;
+    }
+    target(target const &other) : target{other.alive, other.value} {}
+    ~target() {
+      value = -1;
+      (*alive)--;
+    }
+
+    auto operator()() const -> int { return value; }
+  };
+
+  auto alive = std::make_shared<std::atomic<int>>(0);
+  rebindable_closure<int(), target> cls{alive, 0};
+  auto fn = cls.get();
+
+  std::atomic<bool> done = false;
+  std::atomic<int> invalid = 0;
+  {
+    std::vector<std::jthread> callers;
+    for (int t = 0; t < thread_count; t++) {
+      callers.emplace_back([&] {
+        int last = 0;
+        while (not done) {
+          auto const value = fn();
+          if (value < last) {
+            invalid++;
+          }
+          last = value;
+        }
+      });
+    }
+
+    for (int i = 1; i <= rebinds; i++) {
+      cls.payload().rebind(alive, i);
+    }
+    done = true;
+  }
+
+  EXPECT_EQ(invalid, 0);
+  EXPECT_EQ(fn(), rebinds);
+
+  wait_for_retired_closures();
+  EXPECT_EQ(*alive, 1);
+}
+
+} // namespace
+} // namespace voidstar::test
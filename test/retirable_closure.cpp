@@ -0,0 +1,243 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/retirable_closure.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+using example_retirable = retirable_closure<void(), void (*)()>;
+
+static_assert(std::is_nothrow_move_constructible_v<example_retirable>);
+static_assert(not std::is_copy_constructible_v<example_retirable>);
+
+struct tracked_payload {
+  std::atomic<bool> *destroyed;
+  std::atomic<bool> *release;
+  std::atomic<bool> *entered;
+  std::atomic<bool> *exited;
+
+  tracked_payload(std::atomic<bool> *destroyed, std::atomic<bool> *release,
+                  std::atomic<bool> *entered, std::atomic<bool> *exited)
+      : destroyed{destroyed}, release{release}, entered{entered},
+        exited{exited} {}
+  tracked_payload(tracked_payload const &) = delete;
+  ~tracked_payload() {
+    // Destruction must not overlap with a call that entered before retire()
+    EXPECT_TRUE(entered->load() == exited->load());
+    destroyed->store(true);
+  }
+
+  void operator()() const {
+    entered->store(true);
+    while (not release->load()) {
+      std::this_thread::yield();
+    }
+    exited->store(true);
+  }
+};
+
+TEST(RetirableClosure, SimpleCall) {
+  int calls = 0;
+
+  auto cls = make_retirable_closure<int(int)>([&](int x) {
+    calls++;
+    return x + 1;
+  });
+
+  EXPECT_EQ(cls.get()(41), 42);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(RetirableClosure, MoveKeepsPointer) {
+  int calls = 0;
+
+  auto cls = make_retirable_closure<void()>([&] { calls++; });
+  void (*const ptr)() = cls;
+
+  auto moved = std::move(cls);
+  EXPECT_FALSE(cls); // NOLINT(bugprone-use-after-move)
+  EXPECT_EQ(moved.get(), ptr);
+
+  ptr();
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(RetirableClosure, RetireWithoutCalls) {
+  std::atomic<bool> destroyed = false;
+  std::atomic<bool> release = true;
+  std::atomic<bool> entered = false;
+  std::atomic<bool> exited = false;
+
+  retirable_closure<void(), tracked_payload> cls{&destroyed, &release,
+                                                 &entered, &exited};
+  cls.retire();
+  EXPECT_FALSE(cls);
+
+  wait_for_retired_closures();
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(RetirableClosure, RetireDuringCall) {
+  std::atomic<bool> destroyed = false;
+  std::atomic<bool> release = false;
+  std::atomic<bool> entered = false;
+  std::atomic<bool> exited = false;
+
+  retirable_closure<void(), tracked_payload> cls{&destroyed, &release,
+                                                 &entered, &exited};
+
+  std::jthread caller{cls.get()};
+  while (not entered) {
+    std::this_thread::yield();
+  }
+
+  cls.retire(); // Returns while the call is in flight
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  EXPECT_FALSE(destroyed);
+
+  release = true;
+  wait_for_retired_closures();
+  EXPECT_TRUE(exited);
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(RetirableClosure, DestructorRetires) {
+  std::atomic<bool> destroyed = false;
+  std::atomic<bool> release = true;
+  std::atomic<bool> entered = false;
+  std::atomic<bool> exited = false;
+
+  {
+    retirable_closure<void(), tracked_payload> cls{&destroyed, &release,
+                                                   &entered, &exited};
+    cls.get()();
+  }
+
+  wait_for_retired_closures();
+  EXPECT_TRUE(destroyed);
+}
+
+TEST(RetirableClosure, ConcurrentCallsAndRetirement) {
+  constexpr int closure_count = 200;
+  constexpr int thread_count = 4;
+
+  std::atomic<int> calls = 0;
+  std::atomic<int> destroyed = 0;
+
+  struct payload {
+    std::atomic<int> *calls;
+    std::atomic<int> *destroyed;
+
+    payload(std::atomic<int> *calls, std::atomic<int> *destroyed)
+        : calls{calls}, destroyed{destroyed} {}
+    payload(payload const &) = delete;
+    ~payload() { destroyed->fetch_add(1); }
+    void operator()() const { calls->fetch_add(1); }
+  };
+
+  for (int i = 0; i < closure_count; i++) {
+    retirable_closure<void(), payload> cls{&calls, &destroyed};
+    void (*const ptr)() = cls;
+
+    std::atomic<bool> start = false;
+    std::vector<std::jthread> callers;
+    for (int t = 0; t < thread_count; t++) {
+      callers.emplace_back([&] {
+        while (not start) {
+          std::this_thread::yield();
+        }
+        ptr();
+      });
+    }
+
+    start = true;
+
+    // Calls must have reached the payload before the closure is retired
+    while (calls < (i + 1) * thread_count) {
+      std::this_thread::yield();
+    }
+    cls.retire();
+  }
+
+  wait_for_retired_closures();
+  EXPECT_EQ(calls, closure_count * thread_count);
+  EXPECT_EQ(destroyed, closure_count);
+}
+
+/// @brief In-flight tracking whose per-call scope, which reads the closure,
+/// blocks until released.
+struct blocking_hooks : detail::reclaim::in_flight_tracking {
+  static inline std::atomic<int> waiting = 0;
+  static inline std::atomic<bool> release = false;
+
+  struct scope {
+    explicit scope(blocking_hooks & /* hooks */) noexcept {
+      waiting++;
+      while (not release) {
+        std::this_thread::yield();
+      }
+    }
+  };
+};
+
+TEST(RetirableClosure, RetireWhileCallsHaveNotReachedPayload) {
+  constexpr int thread_count = 4;
+
+  std::atomic<int> calls = 0;
+  std::atomic<bool> destroyed = false;
+
+  struct payload {
+    std::atomic<int> *calls;
+    std::atomic<bool> *destroyed;
+
+    payload(std::atomic<int> *calls, std::atomic<bool> *destroyed)
+        : calls{calls}, destroyed{destroyed} {}
+    payload(payload const &) = delete;
+    ~payload() { destroyed->store(true); }
+    void operator()() const {
+      EXPECT_FALSE(destroyed->load());
+      calls->fetch_add(1);
+    }
+  };
+
+  using closure_type =
+      detail::closure_impl<detail::call_signature<void()>, payload,
+                           detail::ffi::closure, blocking_hooks>;
+  detail::retirable_handle<closure_type> cls{&calls, &destroyed};
+  void (*const ptr)() = cls;
+
+  std::vector<std::jthread> callers;
+  for (int t = 0; t < thread_count; t++) {
+    callers.emplace_back(ptr);
+  }
+
+  // Every call is inside the closure but none has reached the payload
+  while (blocking_hooks::waiting < thread_count) {
+    std::this_thread::yield();
+  }
+  cls.retire();
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  EXPECT_FALSE(destroyed);
+
+  blocking_hooks::release = true;
+  callers.clear();
+  wait_for_retired_closures();
+  EXPECT_EQ(calls, thread_count);
+  EXPECT_TRUE(destroyed);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,125 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/closure_registry.h>
+#include <voidstar/direct_closure.h>
+#include <voidstar/static_closure.h>
+
+#include <type_traits>
+#include <typeindex>
+
+namespace voidstar::test {
+namespace {
+
+auto add_one(int x) -> int { return x + 1; }
+
+auto widen(long x) noexcept -> long { return x * 2; }
+
+struct doubler {
+  auto operator()(int x) const -> int { return x * 2; }
+};
+
+struct counter {
+  int calls = 0;
+  auto operator()(int x) -> int {
+    calls++;
+    return x;
+  }
+};
+
+static_assert(detail::stateless_payload<doubler>);
+static_assert(not detail::stateless_payload<counter>);
+static_assert(not detail::stateless_payload<int (*)(int)>);
+
+static_assert(std::same_as<stateless_closure<int(int), doubler>::trampoline_type,
+                           detail::static_trampoline>);
+static_assert(std::same_as<closure<int(int), doubler>::trampoline_type,
+                           detail::ffi::closure>);
+
+TEST(StaticClosure, StatelessClosureSharesFunction) {
+  stateless_closure<int(int), doubler> const first{};
+  stateless_closure<int(int), doubler> const second{};
+
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(first.get()(21), 42);
+}
+
+TEST(StaticClosure, StatelessLambda) {
+  auto const cls = make_stateless_closure<int(int, int)>([](int a, int b) {
+    return a - b;
+  });
+  EXPECT_EQ(cls.get()(5, 3), 2);
+}
+
+TEST(StaticClosure, ClosureOfStatelessPayloadIsUnique) {
+  closure<int(int), doubler> const first{};
+  closure<int(int), doubler> const second{};
+
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_EQ(first.get()(21), 42);
+
+  auto const direct =
+      make_direct_closure<void(int *)>([](int *out) { *out = 7; });
+  int out = 0;
+  direct.get()(&out);
+  EXPECT_EQ(out, 7);
+}
+
+TEST(StaticClosure, ClosureOfStatelessPayloadCanBeRegistered) {
+  registered<closure<int(int), doubler>> const cls{};
+
+  auto const info = find_closure(cls.get());
+  ASSERT_TRUE(info.has_value());
+  EXPECT_EQ(info->entry_point, reinterpret_cast<void const *>(cls.get()));
+  EXPECT_EQ(info->payload, std::type_index{typeid(doubler)});
+}
+
+TEST(StaticClosure, StatefulClosureKeepsTrampoline) {
+  closure<int(int), counter> first{};
+  closure<int(int), counter> second{};
+
+  EXPECT_NE(first.get(), second.get());
+  first.get()(1);
+  EXPECT_EQ(first.payload().calls, 1);
+  EXPECT_EQ(second.payload().calls, 0);
+}
+
+TEST(StaticClosure, StatelessHandles) {
+  auto const cls = make_unique_closure<int(int)>(doubler{});
+  EXPECT_EQ(cls.get()(4), 8);
+}
+
+TEST(StaticClosure, FunctionPointerIsUsedAsIs) {
+  EXPECT_EQ(static_closure<&add_one>::get(), &add_one);
+  EXPECT_EQ(static_closure<&add_one>::get()(1), 2);
+
+  // noexcept is dropped without a thunk
+  EXPECT_EQ(static_closure<&widen>::get(), &widen);
+}
+
+TEST(StaticClosure, ConvertedSignature) {
+  // A thunk converts between the signatures
+  auto const fn = static_closure<&widen, int(int)>::get();
+  static_assert(std::same_as<decltype(fn), int (*const)(int)>);
+  EXPECT_EQ(fn(3), 6);
+}
+
+TEST(StaticClosure, Lambda) {
+  constexpr auto negate = [](int x) { return -x; };
+  int (*const fn)(int) = static_closure<negate>{};
+  EXPECT_EQ(fn(5), -5);
+
+  EXPECT_EQ(static_closure<doubler{}>::get()(6), 12);
+  EXPECT_EQ((static_closure<doubler{}, double(double)>::get()(2.5)), 4.0);
+}
+
+TEST(StaticClosure, ConstantEvaluated) {
+  constexpr auto fn = static_closure<&add_one>::value;
+  static_assert(fn == &add_one);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -4,6 +4,7 @@
 #include <gtest/gtest.h>
 
 #include <voidstar.h>
+#include <voidstar/invoker.h>
 
 #include <future>
 #include <list>
@@ -219,5 +220,31 @@ TYPED_TEST(TypeSupport, AsReturnValue) {
   EXPECT_EQ(result, TestFixture::param_value);
 }
 
+template <typename T> auto identity(T val) -> T { return val; }
+
+TYPED_TEST(TypeSupport, InvokerArgumentAndReturnValue) {
+  using type = typename TestFixture::param_type;
+
+  invoker<type(type)> const invoke;
+  type result = invoke(&identity<type>, TestFixture::param_value);
+
+  EXPECT_EQ(result, TestFixture::param_value);
+}
+
+TYPED_TEST(TypeSupport, InvokerArgumentOnStack) {
+  using type = typename TestFixture::param_type;
+
+  auto cls = make_closure<void(VOIDSTAR_8_TIMES(int, float), type,
+                               VOIDSTAR_8_TIMES(int, float))>(
+      [](VOIDSTAR_8_TIMES(int, float), type val, VOIDSTAR_8_TIMES(int, float)) {
+        EXPECT_EQ(val, TestFixture::param_value);
+      });
+
+  invoker<void(VOIDSTAR_8_TIMES(int, float), type,
+               VOIDSTAR_8_TIMES(int, float))> const invoke;
+  invoke(cls.get(), VOIDSTAR_8_TIMES(0, 0.0f), TestFixture::param_value,
+         VOIDSTAR_8_TIMES(0, 0.0f));
+}
+
 } // namespace
 } // namespace voidstar::test
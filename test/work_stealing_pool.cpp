@@ -0,0 +1,131 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/work_stealing_pool.h>
+
+#include <atomic>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+TEST(WorkStealingPool, RunsAllTasks) {
+  std::atomic<int> sum = 0;
+  {
+    work_stealing_pool pool{4};
+    EXPECT_EQ(pool.size(), 4);
+    for (int i = 1; i <= 1000; i++) {
+      pool.submit([&sum, i] { sum += i; });
+    }
+  }
+  EXPECT_EQ(sum, 500500);
+}
+
+TEST(WorkStealingPool, DefaultSize) {
+  work_stealing_pool pool;
+  EXPECT_GE(pool.size(), 1);
+}
+
+TEST(WorkStealingPool, RunningInThisThread) {
+  work_stealing_pool pool{2};
+  EXPECT_FALSE(pool.running_in_this_thread());
+
+  std::latch done{1};
+  bool inside = false;
+  pool.submit([&] {
+    inside = pool.running_in_this_thread();
+    done.count_down();
+  });
+  done.wait();
+  EXPECT_TRUE(inside);
+}
+
+TEST(WorkStealingPool, NestedSubmissions) {
+  constexpr int depth = 10;
+  std::atomic<int> leaves = 0;
+  {
+    work_stealing_pool pool{3};
+
+    // Each task spawns two children from a worker thread
+    struct spawner {
+      work_stealing_pool *pool;
+      std::atomic<int> *leaves;
+      int level;
+      void operator()() const {
+        if (level == 0) {
+          (*leaves)++;
+          return;
+        }
+        pool->submit(spawner{pool, leaves, level - 1});
+        pool->submit(spawner{pool, leaves, level - 1});
+      }
+    };
+    pool.submit(spawner{&pool, &leaves, depth});
+  }
+  EXPECT_EQ(leaves, 1 << depth);
+}
+
+TEST(WorkStealingPool, IdleWorkersSteal) {
+  constexpr int worker_count = 4;
+  work_stealing_pool pool{worker_count};
+
+  std::mutex mutex;
+  std::set<std::thread::id> workers;
+  std::latch done{worker_count};
+
+  // One worker submits everything to its own deque; the others must steal
+  pool.submit([&] {
+    for (int i = 0; i < worker_count; i++) {
+      pool.submit([&] {
+        {
+          std::lock_guard const lock{mutex};
+          workers.insert(std::this_thread::get_id());
+        }
+        done.arrive_and_wait();
+      });
+    }
+  });
+  done.wait();
+
+  EXPECT_EQ(workers.size(), worker_count);
+}
+
+TEST(WorkStealingPool, MoveOnlyTasks) {
+  std::atomic<int> value = 0;
+  {
+    work_stealing_pool pool{1};
+    auto owned = std::make_unique<int>(7);
+    pool.submit([&value, owned = std::move(owned)] { value = *owned; });
+  }
+  EXPECT_EQ(value, 7);
+}
+
+TEST(WorkStealingPool, ConcurrentSubmitters) {
+  constexpr int thread_count = 4;
+  constexpr int tasks_per_thread = 2000;
+
+  std::atomic<int> count = 0;
+  {
+    work_stealing_pool pool{2};
+    std::vector<std::jthread> submitters;
+    for (int t = 0; t < thread_count; t++) {
+      submitters.emplace_back([&] {
+        for (int i = 0; i < tasks_per_thread; i++) {
+          pool.submit([&] { count++; });
+        }
+      });
+    }
+  }
+  EXPECT_EQ(count, thread_count * tasks_per_thread);
+}
+
+} // namespace
+} // namespace voidstar::test
@@ -0,0 +1,133 @@
+// voidstar library. Copyright (c) 2025 OLEGSHA
+// SPDX-License-Identifier: EPL-2.0 OR GPL-2.0 WITH Classpath-exception-2.0
+
+#include <gtest/gtest.h>
+
+#include <voidstar.h>
+#include <voidstar/wrap.h>
+
+#include <string>
+#include <vector>
+
+namespace voidstar::test {
+namespace {
+
+extern "C" auto add(int a, int b) -> int { return a + b; }
+
+int stored = 0;
+extern "C" void store(int value) { stored = value; }
+
+extern "C" auto scaled(double const *factor, int *counter, double x)
+    -> double {
+  (*counter)++;
+  return *factor * x;
+}
+
+TEST(Wrap, BeforeAndAfter) {
+  struct tracer {
+    std::vector<std::string> *log;
+    void before(int a, int b) {
+      log->push_back("before " + std::to_string(a) + " " + std::to_string(b));
+    }
+    void after(int result, int /* a */, int /* b */) {
+      log->push_back("after " + std::to_string(result));
+    }
+  };
+
+  std::vector<std::string> log;
+  auto wrapped = wrap<int(int, int)>(&add, tracer{&log});
+
+  EXPECT_EQ(wrapped.get()(2, 3), 5);
+  EXPECT_EQ(log, (std::vector<std::string>{"before 2 3", "after 5"}));
+  EXPECT_EQ(wrapped.payload().original(), &add);
+}
+
+TEST(Wrap, DeducedSignature) {
+  struct counter {
+    int calls = 0;
+    void before(int, int) { calls++; }
+  };
+
+  auto wrapped = wrap(&add, counter{});
+  static_assert(std::is_same_v<decltype(wrapped.get()), int (*)(int, int)>);
+
+  EXPECT_EQ(wrapped.get()(1, 1), 2);
+  EXPECT_EQ(wrapped.get()(2, 2), 4);
+  EXPECT_EQ(wrapped.payload().decorator().calls, 2);
+}
+
+TEST(Wrap, AfterFixesResult) {
+  struct clamp {
+    void after(int &result, int, int) {
+      if (result > 10) {
+        result = 10;
+      }
+    }
+  };
+
+  auto wrapped = wrap(&add, clamp{});
+  EXPECT_EQ(wrapped.get()(3, 4), 7);
+  EXPECT_EQ(wrapped.get()(30, 4), 10);
+}
+
+TEST(Wrap, AroundDecorator) {
+  // Fixes up an argument and skips the original for some inputs
+  auto wrapped = wrap(&add, [](auto original, int a, int b) {
+    if (a < 0) {
+      return 0;
+    }
+    return original(a, b * 2);
+  });
+
+  EXPECT_EQ(wrapped.get()(1, 2), 5);
+  EXPECT_EQ(wrapped.get()(-1, 2), 0);
+}
+
+TEST(Wrap, VoidFunction) {
+  struct hooks {
+    std::vector<int> *seen;
+    void before(int value) { seen->push_back(value); }
+    void after(int value) { seen->push_back(-value); }
+  };
+
+  std::vector<int> seen;
+  auto wrapped = wrap(&store, hooks{&seen});
+  wrapped.get()(7);
+
+  EXPECT_EQ(stored, 7);
+  EXPECT_EQ(seen, (std::vector<int>{7, -7}));
+}
+
+TEST(Wrap, Chained) {
+  struct plus_one {
+    void after(int &result, int, int) { result++; }
+  };
+
+  auto inner = wrap(&add, plus_one{});
+  auto outer = wrap(inner.get(), plus_one{});
+  EXPECT_EQ(outer.get()(1, 1), 4);
+}
+
+TEST(BindFront, AddsContext) {
+  double const factor = 2.5;
+  int counter = 0;
+
+  auto bound = bind_front<double(double)>(&scaled, &factor, &counter);
+  auto fn = bound.get();
+
+  EXPECT_EQ(fn(2.0), 5.0);
+  EXPECT_EQ(fn(4.0), 10.0);
+  EXPECT_EQ(counter, 2);
+  EXPECT_EQ(bound.payload().original(), &scaled);
+}
+
+TEST(BindFront, BindsValues) {
+  auto increment = bind_front<int(int)>(&add, 1);
+  EXPECT_EQ(increment.get()(41), 42);
+
+  auto constant = bind_front<int()>(&add, 20, 22);
+  EXPECT_EQ(constant.get()(), 42);
+}
+
+} // namespace
+} // namespace voidstar::test